@@ -0,0 +1,37 @@
+#ifndef CASIMIR_BENCH_HPP_
+#define CASIMIR_BENCH_HPP_
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <casimir/casimir.hpp>
+
+namespace CasimirBench {
+
+    /**
+     * @brief Measure the wall-clock time taken by `function`
+     * @param function the function to be measured
+     * @return the elapsed time in seconds
+     */
+    template<typename Function>
+    inline double measure(Function&& function) {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    /**
+     * @brief Print the throughput of a benchmark in a fixed aligned format
+     * @param name the name of the benchmark
+     * @param operations the number of operations performed
+     * @param seconds the time taken to perform the `operations`
+     */
+    inline void report(const std::string& name, Casimir::cuint operations, double seconds) {
+        std::printf("%-50s %12.0f ops/s  %10.2f ns/op\n", name.c_str(),
+                    (double) operations / seconds, seconds * 1e9 / (double) operations);
+    }
+}
+
+#endif
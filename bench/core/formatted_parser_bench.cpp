@@ -0,0 +1,34 @@
+#include "../bench.hpp"
+#include <casimir/core/private-context.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+static String words(cuint length) {
+    String result;
+    while (result.length() < length) {
+        result.append("lorem ipsum dolor sit amet consectetur ");
+    }
+    return result.substr(0, length);
+}
+
+static void run(const char* name, const String& msg, cuint count) {
+    const String time = formattedTime();
+    cuint total = 0;
+    const double seconds = CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) {
+            total += formattedParser(msg, "INFO", time).length();
+        }
+    });
+    CasimirBench::report(name, count, seconds);
+    if (total == 0) std::printf("unexpected empty output\n");
+}
+
+int main(int, char**) {
+    run("formattedParser 40 bytes", words(40), 1000000);
+    run("formattedParser 200 bytes", words(200), 500000);
+    run("formattedParser 10 KiB", words(10 * 1024), 10000);
+    run("formattedParser 1 MiB", words(1024 * 1024), 20);
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../bench.hpp"
+#include <casimir/utilities/concurrent_queue.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+/**
+ * @brief Baseline bounded queue protected by a std::mutex
+ */
+class MutexDeque {
+private:
+    const cuint m_capacity;
+    std::deque<cuint> m_values;
+    std::mutex m_mutex;
+
+public:
+    explicit MutexDeque(cuint capacity) : m_capacity(capacity) {}
+
+    bool tryPush(cuint value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_values.size() >= m_capacity) return false;
+        m_values.push_back(value);
+        return true;
+    }
+
+    bool tryPop(cuint& value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_values.empty()) return false;
+        value = m_values.front();
+        m_values.pop_front();
+        return true;
+    }
+};
+
+/**
+ * @brief Move `producers * count` values through the queue with `consumers` consumer threads
+ * @return the elapsed time in seconds
+ */
+template<typename Push, typename Pop>
+static double run(cuint producers, cuint consumers, cuint count, Push&& push, Pop&& pop) {
+    std::atomic<bool> start(false);
+    std::atomic<cuint> popped(0);
+    std::vector<std::thread> threads;
+    for (cuint p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (cuint i = 0; i < count;) {
+                const cuint pushed = push(i);
+                if (pushed == 0) std::this_thread::yield();
+                i += pushed;
+            }
+        });
+    }
+    for (cuint c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            while (popped.load(std::memory_order_relaxed) < producers * count) {
+                const cuint received = pop();
+                if (received == 0) std::this_thread::yield();
+                popped.fetch_add(received, std::memory_order_relaxed);
+            }
+        });
+    }
+    return CasimirBench::measure([&]() {
+        start.store(true, std::memory_order_release);
+        for (auto& thread : threads) thread.join();
+    });
+}
+
+int main(int, char**) {
+    const cuint count = 200000;
+    const cuint capacity = 1024;
+    const cuint batchSize = 16;
+    for (cuint threads : {1, 2, 4, 8}) {
+        const std::string suffix = " " + std::to_string(threads) + "P/" + std::to_string(threads) + "C";
+
+        ConcurrentQueue<cuint> queue(capacity);
+        CasimirBench::report("ConcurrentQueue" + suffix, threads * count, run(threads, threads, count,
+            [&](cuint i) { return queue.tryPush(i) ? 1 : 0; },
+            [&]() { cuint value; return queue.tryPop(value) ? 1 : 0; }));
+
+        ConcurrentQueue<cuint> batchQueue(capacity);
+        CasimirBench::report("ConcurrentQueue batch" + suffix, threads * count, run(threads, threads, count,
+            [&](cuint i) {
+                cuint values[batchSize];
+                for (cuint j = 0; j < batchSize; ++j) values[j] = i + j;
+                return batchQueue.tryPushBatch(values, std::min<cuint>(batchSize, count - i));
+            },
+            [&]() { cuint values[batchSize]; return batchQueue.tryPopBatch(values, batchSize); }));
+
+        MutexDeque deque(capacity);
+        CasimirBench::report("std::mutex + std::deque" + suffix, threads * count, run(threads, threads, count,
+            [&](cuint i) { return deque.tryPush(i) ? 1 : 0; },
+            [&]() { cuint value; return deque.tryPop(value) ? 1 : 0; }));
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <atomic>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../bench.hpp"
+#include <casimir/utilities/concurrent_uuid_map.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+/**
+ * @brief Run `threads` threads that each perform `count` operations on random keys, one in `writeEvery` being a write
+ * @return the elapsed time in seconds
+ */
+template<typename Read, typename Write>
+static double run(const std::vector<Uuid>& keys, cuint threads, cuint count, cuint writeEvery, Read&& read,
+                  Write&& write) {
+    std::atomic<bool> start(false);
+    std::vector<std::thread> workers;
+    for (cuint t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            cuint index = t * 7919;
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (cuint i = 0; i < count; ++i) {
+                index = (index * 6364136223846793005ULL + 1442695040888963407ULL);
+                const Uuid& key = keys[(index >> 33U) % keys.size()];
+                if (writeEvery != 0 && (i + t) % writeEvery == 0) write(key, i);
+                else read(key);
+            }
+        });
+    }
+    return CasimirBench::measure([&]() {
+        start.store(true, std::memory_order_release);
+        for (auto& worker : workers) worker.join();
+    });
+}
+
+int main(int, char**) {
+    const cuint count = 200000;
+    UuidRandomGenerator generator(42);
+    std::vector<Uuid> keys;
+    for (cuint i = 0; i < 10000; ++i) keys.push_back(generator.nextUuid());
+
+    for (cuint writeEvery : {(cuint) 0, (cuint) 100}) {
+        for (cuint threads : {1, 4, 16}) {
+            const std::string suffix = " " + std::to_string(threads) + " threads" +
+                                       (writeEvery ? ", 1% writes" : ", reads only");
+            volatile cuint sink = 0;
+
+            ConcurrentUuidMap<cuint> map;
+            for (cuint i = 0; i < keys.size(); ++i) map.insert(keys[i], i);
+            CasimirBench::report("ConcurrentUuidMap" + suffix, threads * count, run(keys, threads, count, writeEvery,
+                [&](const Uuid& key) { cuint value = 0; map.find(key, value); sink = value; },
+                [&](const Uuid& key, cuint value) { map.insertOrAssign(key, value); }));
+
+            std::unordered_map<Uuid, cuint> unorderedMap;
+            std::shared_mutex mutex;
+            for (cuint i = 0; i < keys.size(); ++i) unorderedMap[keys[i]] = i;
+            CasimirBench::report("locked std::unordered_map" + suffix, threads * count,
+                run(keys, threads, count, writeEvery,
+                    [&](const Uuid& key) {
+                        std::shared_lock<std::shared_mutex> lock(mutex);
+                        sink = unorderedMap.find(key)->second;
+                    },
+                    [&](const Uuid& key, cuint value) {
+                        std::unique_lock<std::shared_mutex> lock(mutex);
+                        unorderedMap[key] = value;
+                    }));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include <cstdio>
+#include <memory>
+
+#include "../bench.hpp"
+#include <casimir/utilities/logger.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+static const Uuid InfoChannel  = Uuid(1, 1);
+static const Uuid ErrorChannel = Uuid(2, 2);
+
+static void run(const char* name, const std::shared_ptr<FileLogger>& fileLogger, cuint count, const String& msg) {
+    const double seconds = CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) {
+            fileLogger->logFrom(i % 1000 == 0 ? ErrorChannel : InfoChannel, msg);
+        }
+        fileLogger->flush();
+    });
+    CasimirBench::report(name, count, seconds);
+}
+
+int main(int, char**) {
+    const char* filepath = "casimir_file_logger_bench.log";
+    const cuint count = 200000;
+    const String msg = String('x', 120) + "\n";
+
+    std::remove(filepath);
+    run("FileLogger per-line flush", std::make_shared<FileLogger>(filepath), count, msg);
+
+    std::remove(filepath);
+    run("FileLogger buffered 64KiB", std::make_shared<FileLogger>(
+            filepath, 64 * 1024, std::chrono::milliseconds(1000)), count, msg);
+
+    std::remove(filepath);
+    run("FileLogger buffered 64KiB + immediate ERROR", std::make_shared<FileLogger>(
+            filepath, 64 * 1024, std::chrono::milliseconds(1000), std::vector<Uuid>{ErrorChannel}), count, msg);
+
+    std::remove(filepath);
+    return 0;
+}
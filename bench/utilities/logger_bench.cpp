@@ -0,0 +1,55 @@
+#include "../bench.hpp"
+#include <casimir/utilities/logger.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+/**
+ * @brief Logger channel that discards everything to only measure the cost of the Logger itself
+ */
+class NullLogger : public AbstractLoggerChannel {
+public:
+    void log(const String& msg) override {}
+};
+
+static const Uuid Channel = Uuid(1, 1);
+
+int main(int, char**) {
+    const cuint count = 5000000;
+    Logger logger = LoggerBuilder()
+            .registerChannelAt(Channel, std::make_shared<NullLogger>(), [](const String& msg) { return msg; })
+            .create();
+    const LoggerChannelHandle handle = logger.resolve(Channel);
+
+    CasimirBench::report("logger(uuid) << int", count, CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) logger(Channel) << (cint) i;
+    }));
+    CasimirBench::report("handle() << int", count, CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) handle() << (cint) i;
+    }));
+
+    // Caller side cost only: the conversion to text happens on the background thread
+    Logger asyncLogger = LoggerBuilder()
+            .registerChannelAt(Channel, std::make_shared<NullLogger>(), [](const String& msg) { return msg; })
+            .setAsynchronous(1U << 16U)
+            .create();
+    const LoggerChannelHandle asyncHandle = asyncLogger.resolve(Channel);
+    const cuint asyncCount = 1U << 15U;
+    CasimirBench::report("async handle() << int << double << ptr", asyncCount, CasimirBench::measure([&]() {
+        for (cuint i = 0; i < asyncCount; ++i) asyncHandle() << (cint) i << 0.5 << (const void*) &i;
+    }));
+    asyncLogger.flush();
+
+    logger.setEnabled(Channel, false);
+    CasimirBench::report("logger(uuid) << int (disabled)", count, CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) logger(Channel) << (cint) i;
+    }));
+    CasimirBench::report("CASIMIR_LOG << int (disabled)", count, CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) CASIMIR_LOG(logger, LoggerLevel::Info, Channel) << (cint) i;
+    }));
+    CasimirBench::report("CASIMIR_LOG_HANDLE << int (disabled)", count, CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) CASIMIR_LOG_HANDLE(handle, LoggerLevel::Info) << (cint) i;
+    }));
+    return 0;
+}
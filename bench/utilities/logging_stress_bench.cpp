@@ -0,0 +1,325 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../bench.hpp"
+#include <casimir/utilities/logger.hpp>
+#include <casimir/utilities/cmutex.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+/**
+ * Stress harness of the logging backends with many concurrent producers. Each producer measures the latency of
+ * every single call, the throughput is measured over the whole run (including the final flush)
+ *
+ * Usage: bench-utilities-logging_stress_bench [--producers 1,2,4] [--sizes 64,512] [--mixes single,mixed,gated]
+ *        [--sinks logger,logger-async,file,shell,mutex] [--messages N] [--output results.json]
+ *
+ * The shell sink writes to stderr (redirect it to /dev/null or to a pipe), the results table goes to stdout
+ */
+
+/**
+ * @brief Logger channel that discards everything to only measure the cost of the Logger itself
+ */
+class NullLogger : public AbstractLoggerChannel {
+public:
+    void log(const String& msg) override {}
+};
+
+static const Uuid InfoChannel    = Uuid(1, 1);
+static const Uuid WarningChannel = Uuid(2, 2);
+static const Uuid ErrorChannel   = Uuid(3, 3);
+static const Uuid MutedChannel   = Uuid(4, 4);
+
+/**
+ * @brief Log-linear latency histogram (16 sub-buckets per power of two, about 6% of relative error)
+ */
+class LatencyHistogram {
+private:
+    static constexpr cuint s_subBuckets = 16;
+    static constexpr cuint s_buckets = 64 * s_subBuckets;
+    std::vector<uint64> m_counts;
+    uint64 m_max;
+
+    static cuint bucketOf(uint64 value) {
+        if (value < s_subBuckets) return (cuint) value;
+        cuint exponent = 63;
+        while (!((value >> exponent) & 1U)) --exponent;
+        return (exponent - 3) * s_subBuckets + (cuint) ((value >> (exponent - 4)) & (s_subBuckets - 1));
+    }
+
+    static uint64 lowerBoundOf(cuint bucket) {
+        if (bucket < s_subBuckets) return bucket;
+        const cuint exponent = bucket / s_subBuckets + 3;
+        return (uint64) (s_subBuckets + bucket % s_subBuckets) << (exponent - 4);
+    }
+
+public:
+    LatencyHistogram() : m_counts(s_buckets, 0), m_max(0) {}
+
+    inline void record(uint64 nanoseconds) {
+        ++m_counts[bucketOf(nanoseconds)];
+        m_max = std::max(m_max, nanoseconds);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (cuint i = 0; i < s_buckets; ++i) m_counts[i] += other.m_counts[i];
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    uint64 percentile(double fraction) const {
+        uint64 total = 0;
+        for (uint64 count : m_counts) total += count;
+        const auto target = (uint64) ((double) total * fraction);
+        uint64 seen = 0;
+        for (cuint i = 0; i < s_buckets; ++i) {
+            seen += m_counts[i];
+            if (seen > target) return std::min(lowerBoundOf(i), m_max);
+        }
+        return m_max;
+    }
+
+    uint64 max() const {
+        return m_max;
+    }
+};
+
+/**
+ * @brief A sink under test: `call` performs one logging call from a producer, `finish` waits for every message
+ * to be written
+ */
+struct Sink {
+    std::function<void(const Uuid&, const String&)> call;
+    std::function<void()> finish;
+};
+
+struct Result {
+    std::string sink;
+    std::string mix;
+    cuint producers;
+    cuint messageSize;
+    cuint operations;
+    double seconds;
+    LatencyHistogram latency;
+};
+
+/**
+ * @brief Create the sink `name`
+ * @return false if the sink is unknown
+ */
+static bool createSink(const std::string& name, Sink& sink, const char* filepath) {
+    if (name == "logger" || name == "logger-async") {
+        LoggerBuilder builder;
+        std::shared_ptr<NullLogger> null = std::make_shared<NullLogger>();
+        for (const Uuid& channel : {InfoChannel, WarningChannel, ErrorChannel, MutedChannel}) {
+            builder.registerChannelAt(channel, null, [](const String& msg) { return msg; });
+        }
+        if (name == "logger-async") builder.setAsynchronous(1U << 16U, LoggerOverflowPolicy::Block);
+        auto logger = std::make_shared<Logger>(builder.create());
+        logger->setEnabled(MutedChannel, false);
+        sink.call = [logger](const Uuid& channel, const String& msg) {
+            CASIMIR_LOG(*logger, LoggerLevel::Info, channel) << msg;
+        };
+        sink.finish = [logger]() { logger->flush(); };
+        return true;
+    }
+    if (name == "file") {
+        std::remove(filepath);
+        auto fileLogger = std::make_shared<FileLogger>(filepath, 64 * 1024, std::chrono::milliseconds(1000),
+                                                       std::vector<Uuid>{ErrorChannel});
+        sink.call = [fileLogger](const Uuid& channel, const String& msg) { fileLogger->logFrom(channel, msg); };
+        sink.finish = [fileLogger]() { fileLogger->flush(); };
+        return true;
+    }
+    if (name == "shell") {
+        auto shellLogger = std::make_shared<ShellLogger>(ShellLoggerStream::Stderr);
+        sink.call = [shellLogger](const Uuid&, const String& msg) { shellLogger->log(msg); };
+        sink.finish = [shellLogger]() { shellLogger->flush(); };
+        return true;
+    }
+    if (name == "mutex") {
+        auto mutex = std::make_shared<Mutex>();
+        auto counter = std::make_shared<cuint>(0);
+        sink.call = [mutex, counter](const Uuid&, const String&) {
+            mutex->acquireLock();
+            ++*counter;
+            mutex->releaseLock();
+        };
+        sink.finish = []() {};
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Build the sequence of channels logged into by a producer for the mix `mix`
+ * @return false if the mix is unknown
+ */
+static bool createMix(const std::string& mix, std::vector<Uuid>& channels) {
+    channels.clear();
+    for (cuint i = 0; i < 100; ++i) {
+        if (mix == "single") {
+            channels.push_back(InfoChannel);
+        } else if (mix == "mixed") { // 90% info, 9% warning, 1% error
+            channels.push_back(i == 0 ? ErrorChannel : (i % 11 == 1 ? WarningChannel : InfoChannel));
+        } else if (mix == "gated") { // Half of the messages are logged into a disabled channel
+            channels.push_back(i % 2 == 0 ? InfoChannel : MutedChannel);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+static Result run(const std::string& sinkName, const std::string& mix, cuint producers, cuint messageSize,
+                  cuint messages) {
+    const char* filepath = "casimir_logging_stress_bench.log";
+    Sink sink;
+    createSink(sinkName, sink, filepath);
+    std::vector<Uuid> channels;
+    createMix(mix, channels);
+    const String msg = String('x', messageSize - 1) + "\n";
+
+    std::vector<LatencyHistogram> histograms(producers);
+    std::vector<std::thread> threads;
+    std::atomic<cuint> ready(0);
+    std::atomic<bool> start(false);
+    for (cuint p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            LatencyHistogram& histogram = histograms[p];
+            ready.fetch_add(1);
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (cuint i = 0; i < messages; ++i) {
+                const auto before = std::chrono::steady_clock::now();
+                sink.call(channels[(i + p) % channels.size()], msg);
+                const auto after = std::chrono::steady_clock::now();
+                histogram.record((uint64) std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count());
+            }
+        });
+    }
+    while (ready.load() != producers) std::this_thread::yield();
+
+    Result result{sinkName, mix, producers, messageSize, producers * messages, 0, LatencyHistogram()};
+    result.seconds = CasimirBench::measure([&]() {
+        start.store(true, std::memory_order_release);
+        for (auto& thread : threads) thread.join();
+        sink.finish();
+    });
+    for (const auto& histogram : histograms) result.latency.merge(histogram);
+
+    sink = Sink();
+    std::remove(filepath);
+    return result;
+}
+
+static std::vector<std::string> splitList(const char* list) {
+    std::vector<std::string> values;
+    for (const String& value : String(list).split(",", true)) values.push_back(value.str());
+    return values;
+}
+
+static bool writeJson(const char* filepath, const std::vector<Result>& results) {
+    std::ofstream output(filepath, std::ios_base::out | std::ios_base::trunc);
+    output << "[\n";
+    for (cuint i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "  {\"sink\": \"%s\", \"mix\": \"%s\", \"producers\": %llu, \"message_size\": %llu, "
+                      "\"operations\": %llu, \"seconds\": %.6f, \"throughput\": %.1f, \"latency_ns\": "
+                      "{\"p50\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}}%s\n",
+                      result.sink.c_str(), result.mix.c_str(), (unsigned long long) result.producers,
+                      (unsigned long long) result.messageSize, (unsigned long long) result.operations,
+                      result.seconds, (double) result.operations / result.seconds,
+                      (unsigned long long) result.latency.percentile(0.5),
+                      (unsigned long long) result.latency.percentile(0.99),
+                      (unsigned long long) result.latency.percentile(0.999),
+                      (unsigned long long) result.latency.max(), i + 1 == results.size() ? "" : ",");
+        output << line;
+    }
+    output << "]\n";
+    return (bool) output;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> producers = {"1", "2", "4", "8", "16", "32", "64"};
+    std::vector<std::string> sizes = {"64", "512"};
+    std::vector<std::string> mixes = {"single", "mixed", "gated"};
+    std::vector<std::string> sinks = {"logger", "logger-async", "file", "shell", "mutex"};
+    cuint messages = 20000;
+    const char* output = "casimir_logging_stress_bench.json";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--producers") == 0) producers = splitList(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--sizes") == 0) sizes = splitList(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--mixes") == 0) mixes = splitList(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--sinks") == 0) sinks = splitList(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--messages") == 0) messages = std::stoull(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--output") == 0) output = argv[i + 1];
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    // Reject invalid configurations before running anything
+    Sink sink;
+    std::vector<Uuid> channels;
+    for (const auto& name : sinks) {
+        if (!createSink(name, sink, "casimir_logging_stress_bench.log")) {
+            std::fprintf(stderr, "Unknown sink %s\n", name.c_str());
+            return 1;
+        }
+    }
+    sink = Sink();
+    std::remove("casimir_logging_stress_bench.log");
+    for (const auto& mix : mixes) {
+        if (!createMix(mix, channels)) {
+            std::fprintf(stderr, "Unknown channel mix %s\n", mix.c_str());
+            return 1;
+        }
+    }
+    if (messages == 0) {
+        std::fprintf(stderr, "The number of messages per producer must be positive\n");
+        return 1;
+    }
+
+    std::printf("%-14s %-7s %9s %6s %14s %10s %10s %10s %10s\n", "sink", "mix", "producers", "size",
+                "msg/s", "p50 ns", "p99 ns", "p999 ns", "max ns");
+    std::vector<Result> results;
+    for (const auto& sinkName : sinks) {
+        for (const auto& mix : mixes) {
+            for (const auto& size : sizes) {
+                for (const auto& producerCount : producers) {
+                    const cuint messageSize = std::max<cuint>(std::stoull(size), 1);
+                    results.push_back(run(sinkName, mix, std::stoull(producerCount), messageSize, messages));
+                    const Result& result = results.back();
+                    std::printf("%-14s %-7s %9llu %6llu %14.0f %10llu %10llu %10llu %10llu\n",
+                                result.sink.c_str(), result.mix.c_str(), (unsigned long long) result.producers,
+                                (unsigned long long) result.messageSize, (double) result.operations / result.seconds,
+                                (unsigned long long) result.latency.percentile(0.5),
+                                (unsigned long long) result.latency.percentile(0.99),
+                                (unsigned long long) result.latency.percentile(0.999),
+                                (unsigned long long) result.latency.max());
+                    std::fflush(stdout);
+                }
+            }
+        }
+    }
+
+    if (!writeJson(output, results)) {
+        std::fprintf(stderr, "Cannot write %s\n", output);
+        return 1;
+    }
+    std::printf("Results written to %s\n", output);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <atomic>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../bench.hpp"
+#include <casimir/utilities/cmutex.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+/**
+ * @brief Run `readers` threads that each perform `count` operations, one in `writeEvery` being a write
+ * @return the elapsed time in seconds
+ */
+template<typename ReadFunction, typename WriteFunction>
+static double run(cuint readers, cuint count, cuint writeEvery, ReadFunction&& read, WriteFunction&& write) {
+    std::atomic<bool> start(false);
+    std::vector<std::thread> threads;
+    for (cuint t = 0; t < readers; ++t) {
+        threads.emplace_back([&, t]() {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (cuint i = 0; i < count; ++i) {
+                if (writeEvery != 0 && (i + t) % writeEvery == 0) write();
+                else read();
+            }
+        });
+    }
+    return CasimirBench::measure([&]() {
+        start.store(true, std::memory_order_release);
+        for (auto& thread : threads) thread.join();
+    });
+}
+
+int main(int, char**) {
+    const cuint count = 200000;
+    volatile cuint value = 0;
+    for (cuint writeEvery : {(cuint) 0, (cuint) 1000}) {
+        for (cuint readers : {1, 4, 16, 64}) {
+            const std::string suffix = " " + std::to_string(readers) + " threads" +
+                                       (writeEvery ? ", 0.1% writes" : ", reads only");
+            SharedMutex sharedMutex;
+            CasimirBench::report("SharedMutex" + suffix, readers * count, run(readers, count, writeEvery,
+                [&]() { sharedMutex.acquireSharedLock(); const cuint current = value; (void) current; sharedMutex.releaseSharedLock(); },
+                [&]() { sharedMutex.acquireLock(); value = value + 1; sharedMutex.releaseLock(); }));
+
+            std::shared_mutex stdSharedMutex;
+            CasimirBench::report("std::shared_mutex" + suffix, readers * count, run(readers, count, writeEvery,
+                [&]() { stdSharedMutex.lock_shared(); const cuint current = value; (void) current; stdSharedMutex.unlock_shared(); },
+                [&]() { stdSharedMutex.lock(); value = value + 1; stdSharedMutex.unlock(); }));
+        }
+    }
+    return 0;
+}
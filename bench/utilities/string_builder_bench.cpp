@@ -0,0 +1,44 @@
+#include <string>
+#include <vector>
+
+#include "../bench.hpp"
+#include <casimir/utilities/exception.hpp>
+#include <casimir/utilities/string.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+template<typename Function>
+static void run(const std::string& name, cuint count, Function&& function) {
+    cuint total = 0;
+    const double seconds = CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) total += function();
+    });
+    CasimirBench::report(name, count, seconds);
+    if (total == 0) std::printf("unexpected empty result\n");
+}
+
+int main(int, char**) {
+    const String separator(", ");
+    for (cuint size : {(cuint) 8, (cuint) 1000, (cuint) 100000}) {
+        std::vector<String> list;
+        for (cuint i = 0; i < size; ++i) list.emplace_back(String::toString((cint) i) + " item");
+        run("String::join (" + std::to_string(size) + " Strings)", 10000000 / size / 10 + 1,
+            [&]() { return separator.join(list).length(); });
+    }
+
+    const String file(__FILE__);
+    const String cause("Cannot perform the given operation as the specified region isn't fully contained by the string");
+    run("Exception message", 1000000, [&]() {
+        return Exception("IndexOutOfRange", cause, file, __LINE__).toString().length();
+    });
+
+    // Chained concatenation of a growing message
+    run("operator+ chain (64 parts)", 100000, [&]() {
+        String message("Parts:");
+        for (cuint i = 0; i < 64; ++i) message = std::move(message) + " " + cause;
+        return message.length();
+    });
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "../bench.hpp"
+#include <casimir/utilities/string.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+/**
+ * @brief The conversion String::toUpperCase used to perform (one byte at a time through operator[])
+ */
+static String byteWiseUpperCase(const String& data) {
+    String result(data);
+    for (cuint i = 0; i < data.length(); ++i) {
+        char& value = result[i];
+        if (value >= 'a' && value <= 'z') value -= 0x20;
+    }
+    return result;
+}
+
+template<typename Function>
+static void run(const std::string& name, cuint count, cuint bytes, Function&& function) {
+    cuint total = 0;
+    const double seconds = CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) total += function();
+    });
+    CasimirBench::report(name, count, seconds);
+    std::printf("%-50s %12.2f GB/s\n", "", (double) (count * bytes) / seconds * 1e-9);
+    if (total == 0) std::printf("unexpected empty output\n");
+}
+
+int main(int, char**) {
+    // Printable ASCII text with a few line breaks
+    std::mt19937 generator(42);
+    for (cuint size : {(cuint) 16, (cuint) 1024, (cuint) 16 * 1024 * 1024}) {
+        std::string bytes(size, '\0');
+        for (char& c : bytes) c = generator() % 64 == 0 ? '\n' : (char) (' ' + generator() % 95);
+        String data(bytes);
+        const String hex = data.encodeToHex();
+        const cuint count = std::max<cuint>(4, 64 * 1024 * 1024 / size);
+        const std::string suffix = " " + std::to_string(size) + " B";
+
+        run("toUpperCase" + suffix, count, size, [&]() { return data.toUpperCase().length(); });
+        run("byte-wise toUpperCase" + suffix, count, size, [&]() { return byteWiseUpperCase(data).length(); });
+        run("makeUpperCase" + suffix, count, size, [&]() {
+            data.makeUpperCase();
+            return data.length();
+        });
+        run("isAscii" + suffix, count, size, [&]() { return data.isAscii() ? 1 : 0; });
+        run("count" + suffix, count, size, [&]() { return data.count('\n') + 1; });
+        run("std::count" + suffix, count, size, [&]() {
+            return (cuint) std::count(data.c_str(), data.c_str() + data.length(), '\n') + 1;
+        });
+        run("findFirstNotHex" + suffix, count, 2 * size, [&]() {
+            return hex.findFirstNotHex() == String::notFound() ? 1 : 0;
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "../bench.hpp"
+#include <casimir/utilities/string.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+/**
+ * @brief The encoding String::encodeToHex used to perform (one byte at a time through operator[])
+ */
+static String byteWiseEncode(const String& data) {
+    static constexpr char hexAlphabet[] = "0123456789abcdef";
+    String output('\0', 2 * data.length());
+    for (cuint i = 0; i < data.length(); ++i) {
+        const char value = data[i];
+        output[2 * i] = hexAlphabet[((value >> 4) & 0x0F)];
+        output[2 * i + 1] = hexAlphabet[(value & 0x0F)];
+    }
+    return output;
+}
+
+template<typename Function>
+static void run(const std::string& name, cuint count, cuint bytes, Function&& function) {
+    cuint total = 0;
+    const double seconds = CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) total += function().length();
+    });
+    CasimirBench::report(name, count, seconds);
+    std::printf("%-50s %12.2f GB/s\n", "", (double) (count * bytes) / seconds * 1e-9);
+    if (total == 0) std::printf("unexpected empty output\n");
+}
+
+int main(int, char**) {
+    std::mt19937 generator(42);
+    for (cuint size : {(cuint) 16, (cuint) 1024, (cuint) 16 * 1024 * 1024}) {
+        std::string bytes(size, '\0');
+        for (char& c : bytes) c = (char) generator();
+        const String data(bytes);
+        const String hex = data.encodeToHex();
+        const cuint count = std::max<cuint>(4, 64 * 1024 * 1024 / size);
+        const std::string suffix = " " + std::to_string(size) + " B";
+
+        run("encodeToHex" + suffix, count, size, [&]() { return data.encodeToHex(); });
+        run("byte-wise encode" + suffix, count, size, [&]() { return byteWiseEncode(data); });
+        run("decodeFromHex" + suffix, count, size, [&]() { return hex.decodeFromHex(); });
+    }
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <random>
+#include <string>
+
+#include "../bench.hpp"
+#include <casimir/utilities/string_replacer.hpp>
+#include <casimir/utilities/uuid.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+template<typename Function>
+static void run(const std::string& name, cuint count, Function&& function) {
+    cuint total = 0;
+    const double seconds = CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) total += function();
+    });
+    CasimirBench::report(name, count, seconds);
+    if (total == 0) std::printf("unexpected empty result\n");
+}
+
+int main(int, char**) {
+    // 1 MiB of log lines with a few control characters to escape
+    std::mt19937 generator(3);
+    std::string bytes(1024 * 1024, ' ');
+    for (char& c : bytes) {
+        const cuint value = generator() % 64;
+        c = value == 0 ? '\n' : (value == 1 ? '\t' : (value == 2 ? '\r' : (char) ('a' + value % 26)));
+    }
+    const String log(bytes);
+
+    run("chained replaceAll (3 escapes, 1 MiB)", 20, [&]() {
+        return log.replaceAll("\n", "\\n").replaceAll("\t", "\\t").replaceAll("\r", "\\r").length();
+    });
+    const StringReplacer escape({{"\n", "\\n"}, {"\t", "\\t"}, {"\r", "\\r"}});
+    run("StringReplacer (3 escapes, 1 MiB)", 20, [&]() { return escape.apply(log).length(); });
+
+    run("chained replaceAll (3 words, 1 MiB)", 20, [&]() {
+        return log.replaceAll("abc", "1").replaceAll("xyz", "2").replaceAll("kl", "3").length();
+    });
+    const StringReplacer words({{"abc", "1"}, {"xyz", "2"}, {"kl", "3"}});
+    run("StringReplacer (3 words, 1 MiB)", 20, [&]() { return words.apply(log).length(); });
+
+    const String formatted = Uuid(5156165181, 982928983).formattedString();
+    run("Uuid::fromParsedString", 1000000, [&]() {
+        return Uuid::fromParsedString(formatted).isPresent() ? 1 : 0;
+    });
+    return 0;
+}
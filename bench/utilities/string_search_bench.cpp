@@ -0,0 +1,67 @@
+#include <cstring>
+#include <string>
+
+#include "../bench.hpp"
+#include <casimir/utilities/string.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+/**
+ * @brief Text looking like the records of a log file, `length` bytes long
+ */
+static String logText(cuint length) {
+    String result;
+    while (result.length() < length) {
+        result.append("[ 2026-01-01 at 10:00:00 [ UTC+0000 ] ]    INFO : lorem ipsum dolor sit amet consectetur\n");
+    }
+    return result.substr(0, length);
+}
+
+/**
+ * @brief The search String::findFirstOf used to perform (memcmp at every position)
+ */
+static cuint naiveFind(const String& text, const String& needle) {
+    for (cuint i = 0; i + needle.length() <= text.length(); ++i) {
+        if (memcmp(text.c_str() + i, needle.c_str(), needle.length()) == 0) return i;
+    }
+    return String::notFound();
+}
+
+template<typename Function>
+static void run(const std::string& name, cuint count, cuint bytes, Function&& function) {
+    cuint total = 0;
+    const double seconds = CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) total += function();
+    });
+    CasimirBench::report(name, count, seconds);
+    std::printf("%-50s %12.2f GB/s\n", "", (double) (count * bytes) / seconds * 1e-9);
+    if (total == 0) std::printf("unexpected result\n");
+}
+
+/**
+ * @brief Search `needle` appended to `text` (forward searches) and prepended to it (backward search) so that the whole
+ * input is scanned
+ */
+static void compare(const std::string& name, const String& text, const String& needle, cuint count) {
+    const String forward = text + needle;
+    const String backward = needle + text;
+    const std::string stdForward = forward.str();
+    const std::string stdNeedle = needle.str();
+    run("findFirstOf " + name, count, forward.length(), [&]() { return forward.findFirstOf(needle); });
+    run("findLastOf " + name, count, backward.length(), [&]() { return backward.findLastOf(needle) + 1; });
+    run("naive memcmp loop " + name, count, forward.length(), [&]() { return naiveFind(forward, needle); });
+    run("std::string::find " + name, count, forward.length(), [&]() { return stdForward.find(stdNeedle); });
+}
+
+int main(int, char**) {
+    const String line = logText(150);
+    compare("150 B, 1 byte", line, "#", 2000000);
+    compare("150 B, 5 bytes", line, "ERROR", 2000000);
+
+    const String large = logText(4 * 1024 * 1024);
+    compare("4 MiB, 5 bytes", large, "ERROR", 50);
+    compare("4 MiB, 40 bytes", large, "consectetur ERROR lorem ipsum dolor sit ", 50);
+    return 0;
+}
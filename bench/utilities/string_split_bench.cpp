@@ -0,0 +1,45 @@
+#include <string>
+#include <vector>
+
+#include "../bench.hpp"
+#include <casimir/utilities/string.hpp>
+#include <casimir/utilities/uuid.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+template<typename Function>
+static void run(const std::string& name, cuint count, Function&& function) {
+    cuint total = 0;
+    const double seconds = CasimirBench::measure([&]() {
+        for (cuint i = 0; i < count; ++i) total += function();
+    });
+    CasimirBench::report(name, count, seconds);
+    if (total == 0) std::printf("unexpected empty result\n");
+}
+
+int main(int, char**) {
+    // Comma separated records of a few words
+    String text;
+    for (cuint i = 0; i < 100000; ++i) text.append(i % 3 == 0 ? "alpha," : (i % 3 == 1 ? "beta gamma," : ",delta,"));
+
+    run("String::split (100k tokens)", 20, [&]() {
+        cuint length = 0;
+        for (const String& token : text.split(",", true)) length += token.length();
+        return length;
+    });
+    run("StringView::split (100k tokens)", 20, [&]() {
+        cuint length = 0;
+        for (const StringView& token : StringView(text).split(",", true)) length += token.length();
+        return length;
+    });
+
+    run("String::replaceAll (100k occurrences)", 20, [&]() { return text.replaceAll(",", ";").length(); });
+
+    const String formatted = Uuid(5156165181, 982928983).formattedString();
+    run("Uuid::fromParsedString", 1000000, [&]() {
+        return Uuid::fromParsedString(formatted).isPresent() ? 1 : 0;
+    });
+    return 0;
+}
@@ -9,9 +9,12 @@
 #define CASIMIR_DESCRIPTION       "Optimise an computational graph for GPU/CPU"
 
 /* #undef CASIMIR_BUILD_SHARED */
-#define CASIMIR_SAFE_CHECK        true
+#define CASIMIR_SAFE_CHECK        ON
 /* #undef CASIMIR_LITERAL_OPERATOR */
 
+// Minimum level of the CASIMIR_LOG call sites kept by the compiler (0 Note, 1 Info, 2 Warning, 3 Error)
+#define CASIMIR_LOG_MIN_LEVEL     0
+
 #ifndef CASIMIR_SAFE_CHECK
 #if defined(_MSC_VER)
 #pragma message ( "WARNING: Casimir was build without the option CASIMIR_SAFE_CHECK. We strongly advise you to re-enable this option as it make the Bug far more complex to understand without it" )
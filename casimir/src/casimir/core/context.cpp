@@ -1,10 +1,12 @@
 #include "context.hpp"
 #include "private-context.hpp"
+#include "../utilities/cmutex.hpp"
 
 namespace Casimir {
 
     CASIMIR_EXPORT CasimirContext createContext(const char* filepath) {
-        utilities::Logger logger = instantiateLogger(filepath);
+        std::shared_ptr<utilities::StringInterner> names = std::make_shared<utilities::StringInterner>();
+        utilities::Logger logger = instantiateLogger(filepath, names);
 
         // Display the header in the logger
         logger(PrivateLogging::Raw) << utilities::String('=', 100) << "\n";
@@ -12,11 +14,38 @@ namespace Casimir {
         logger(PrivateLogging::Raw) << utilities::String(' ', 35) << formattedTime() << "\n";
         logger(PrivateLogging::Raw) << utilities::String('=', 100) << "\n";
 
-        return (CasimirContext) new PrivateCasimirContext{logger};
+        return (CasimirContext) new PrivateCasimirContext{names, logger};
+    }
+
+    CASIMIR_EXPORT void logLockContention(CasimirContext ctx, unsigned int count) {
+        const std::vector<utilities::LockContention> contentions = utilities::LockProfiler::snapshot();
+        CASIMIR_LOG(ctx->logger, utilities::LoggerLevel::Info, PrivateLogging::Info) << "Lock contention report ("
+            << (cuint) contentions.size() << " profiled locks)";
+        for (cuint i = 0; i < contentions.size() && i < count; ++i) {
+            const utilities::LockContention& contention = contentions[i];
+            CASIMIR_LOG(ctx->logger, utilities::LoggerLevel::Info, PrivateLogging::Info) << contention.name << ": "
+                << contention.contendedAcquisitions << "/" << contention.acquisitions << " contended acquisitions, wait "
+                << (cint) contention.totalWait.count() << " ns (max " << (cint) contention.maxWait.count() << " ns), hold "
+                << (cint) contention.totalHold.count() << " ns (max " << (cint) contention.maxHold.count() << " ns), hottest site "
+                << contention.hottestSite;
+        }
     }
 
     CASIMIR_EXPORT void releaseContext(CasimirContext ctx) {
+        // The report is only worth reading if a profiled lock was actually contended (the most contended is first)
+        const std::vector<utilities::LockContention> contentions = utilities::LockProfiler::snapshot();
+        if (!contentions.empty() && contentions.front().contendedAcquisitions != 0) {
+            logLockContention(ctx);
+        }
+
+        const cuint droppedCount = ctx->logger.droppedCount();
+        if (droppedCount != 0) {
+            CASIMIR_LOG(ctx->logger, utilities::LoggerLevel::Warning, PrivateLogging::Warning) << droppedCount << " log messages were dropped because the logging queue was full";
+        }
         ctx->logger(PrivateLogging::Raw) << utilities::String('=', 100) << "\n\n\n\n\n";
+
+        // Every message must reach the logger channels before the context is destroyed
+        ctx->logger.flush();
         delete (PrivateCasimirContext*) ctx;
     }
 
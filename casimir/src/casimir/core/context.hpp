@@ -29,6 +29,14 @@ namespace Casimir {
      * @param ctx the context to be destroyed
      */
     CASIMIR_EXPORT void releaseContext(CasimirContext ctx);
+
+    /**
+     * @brief Log the statistics of the most contended profiled locks (see utilities::LockProfiler) to the Info
+     * channel of the context. This report is also logged by releaseContext when a profiled lock was contended
+     * @param ctx the context to log to
+     * @param count the maximum number of locks reported
+     */
+    CASIMIR_EXPORT void logLockContention(CasimirContext ctx, unsigned int count = 10);
 };
 
 #endif
@@ -1,104 +1,161 @@
 #include "private-context.hpp"
 
-#include <ctime>
 #include <memory>
 #include <map>
+#include <cstring>
 
 namespace Casimir {
 
     using namespace utilities;
     using namespace literals;
 
+    CASIMIR_EXPORT TimestampCache& timestampCache() {
+        static TimestampCache cache;
+        return cache;
+    }
+
     CASIMIR_EXPORT String formattedTime() {
-        // Retrieve current time point
-        time_t timePoint;
-        time(&timePoint);
-
-        // Convert it to tm structure
-#ifdef _WIN32
-        tm* now = new tm();
-        gmtime_s(now, &timePoint);
-#else
-        tm* now = gmtime(&timePoint);
-#endif
-
-        // Retrieve the buffer
-        char buffer[250];
-        strftime(buffer, sizeof(buffer), "%Y-%m-%d at %H:%M:%S [ UTC%z ]", now);
-
-        // No long need for now
-        delete now;
-
-        return String(buffer);
+        return timestampCache().now();
     }
 
-    CASIMIR_EXPORT String formattedParser(const utilities::String& str, const utilities::String& channelName) {
+    /**
+     * @brief Write the formatted message into `output` in a single pass
+     * @param output the String the formatted message is appended to
+     * @param str The message to be formatted
+     * @param channelName The channel name (small name such as ERROR / WARN)
+     * @param time The formatted time of the message
+     * @param timeLength The length of `time`
+     */
+    static void formattedParserInto(String& output, const String& str, const String& channelName,
+                                    const char* time, cuint timeLength) {
         // The expected format is the following one
         // [ DATE ] channelName :   text multiline if require (always aligned)
         //                      |   with wrap capabilities
-        const String currentTime = formattedTime();
-        const String channelNameF = channelName + " : ";
         const cuint timeAndDateSize = 50;
         const cuint lineContentWidth = 60;
         const cuint minLineContentWidth = 30;
+        const cuint continuationSize = 1 + (timeAndDateSize - 2) + 2; // "\n" + alignment + "| "
+        static const char spaces[] = "                                                                ";
+        static_assert(sizeof(spaces) - 1 >= lineContentWidth && sizeof(spaces) - 1 >= timeAndDateSize,
+                      "Not enough spaces for the alignment");
+
+        // Each line consumes at least `minLineContentWidth` characters and never produces more than the width of
+        // a full line, hence a single allocation for the whole message
+        const cuint headerLength = timeLength + 5;
+        const cuint headerPadding = toUnsigned((cint) timeAndDateSize - (cint) headerLength - (cint) channelName.length() - 3);
+        output.reserve(output.length() + headerLength + headerPadding + channelName.length() + 3 +
+                       (str.length() / (minLineContentWidth + 1) + 2) * (lineContentWidth + 1 + continuationSize));
 
         // Create the header part
-        String output = "[ " + currentTime + " ] ";
-        output.append(toUnsigned((cint) timeAndDateSize - (cint) output.length() - (cint) channelNameF.length()), ' ');
-        output.append(channelNameF);
+        output.append("[ ", 2);
+        output.append(time, timeLength);
+        output.append(" ] ", 3);
+        output.append(headerPadding, ' ');
+        output.append(channelName);
+        output.append(" : ", 3);
 
         // Loop other the string and wrap each word if required
+        const char* data = str.c_str();
+        const cuint length = str.length();
         cuint position = 0;
         cuint lineStartingPosition = 0;
-        while (position < str.length()) {
+        while (position < length) {
             // Find next position with a space
-            cuint nextPosition = str.findFirstOf(" ", position);
+            const char* space = (const char*) memchr(data + position, ' ', (size_t) (length - position));
+            const cuint nextPosition = space ? (cuint) (space - data) : String::notFound();
 
             // If the next word doesn't wrap into the line
             if (nextPosition - lineStartingPosition >= lineContentWidth) {
                 // Either word-wrap or space-wrap
-                if (position - lineStartingPosition > minLineContentWidth) { // Space wrap
-                    output.append(str.substr(lineStartingPosition, position - lineStartingPosition));
-                    output.append(lineContentWidth - (position - lineStartingPosition), ' ');
-                    output.append("\n");
-                    output.append(timeAndDateSize - 2, ' ');
-                    output.append("| ");
+                // A word longer than a line right after a space wrap can only be word-wrapped
+                const cuint lineContentLength = position - lineStartingPosition;
+                if (lineContentLength > minLineContentWidth && lineContentLength <= lineContentWidth) { // Space wrap
+                    output.append(data + lineStartingPosition, lineContentLength);
+                    output.append(spaces, lineContentWidth - lineContentLength);
+                    output.append("\n", 1);
+                    output.append(spaces, timeAndDateSize - 2);
+                    output.append("| ", 2);
                     lineStartingPosition = position;
                     position = nextPosition + 1 > nextPosition ? nextPosition + 1 : nextPosition;
                 } else { // Word-wrap (assert nextPosition is valid)
-                    const cuint length = std::min(lineContentWidth - 1, str.length() - lineStartingPosition);
-                    if (str.length() - lineStartingPosition < lineContentWidth) { // If no more line after this one
-                        output.append(str.substr(lineStartingPosition, length) + "\n");
+                    const cuint lineLength = std::min(lineContentWidth - 1, length - lineStartingPosition);
+                    output.append(data + lineStartingPosition, lineLength);
+                    if (length - lineStartingPosition < lineContentWidth) { // If no more line after this one
+                        output.append("\n", 1);
                     }
                     else {
-                        output.append(str.substr(lineStartingPosition, length) + "-\n");
-                        output.append(timeAndDateSize - 2, ' ');
-                        output.append("| ");
+                        output.append("-\n", 2);
+                        output.append(spaces, timeAndDateSize - 2);
+                        output.append("| ", 2);
                     }
-                    lineStartingPosition += length;
+                    lineStartingPosition += lineLength;
                     position = lineStartingPosition;
                 }
             } else {
                 position = nextPosition + 1;
             }
         }
+    }
+
+    CASIMIR_EXPORT String formattedParser(const utilities::String& str, const utilities::String& channelName) {
+        return formattedParser(str, channelName, std::chrono::system_clock::now());
+    }
+
+    CASIMIR_EXPORT String formattedParser(const utilities::String& str, const utilities::String& channelName,
+                                          std::chrono::system_clock::time_point time) {
+        char formattedTime[TimestampCache::maxLength()];
+        const cuint timeLength = timestampCache().formatInto(formattedTime, time);
+        String output;
+        formattedParserInto(output, str, channelName, formattedTime, timeLength);
         return output;
     }
 
-    CASIMIR_EXPORT utilities::Logger instantiateLogger(const String& filepath) {
-        std::shared_ptr<ShellLogger> shellLogger = std::make_shared<ShellLogger>();
-        std::shared_ptr<FileLogger> fileLogger = std::make_shared<FileLogger>(filepath);
+    CASIMIR_EXPORT String formattedParser(const utilities::String& str, const utilities::String& channelName,
+                                          const utilities::String& time) {
+        String output;
+        formattedParserInto(output, str, channelName, time.c_str(), time.length());
+        return output;
+    }
 
-        LoggerBuilder builder = LoggerBuilder();
-        std::vector<std::pair<Uuid, String>> channels = {
+    CASIMIR_EXPORT const std::vector<std::pair<Uuid, String>>& privateChannelNames() {
+        static const std::vector<std::pair<Uuid, String>> channels = {
                 {PrivateLogging::Error, "ERROR"},
                 {PrivateLogging::Info, "INFO"},
                 {PrivateLogging::Warning, "WARN"},
                 {PrivateLogging::Note, "NOTE"},
         };
-        // Adding all the channels that perform parsing
-        for(const auto& channel : channels) {
-            std::function<String(const String&)> parser = [channel](const String& msg){ return formattedParser(msg, channel.second); };
+        return channels;
+    }
+
+    CASIMIR_EXPORT String formattedChannelMessage(const String& msg, const Uuid& channel, const String& time) {
+        if (channel == PrivateLogging::Raw) {
+            return msg;
+        }
+        for (const auto& channelName : privateChannelNames()) {
+            if (channelName.first == channel) {
+                return formattedParser(msg, channelName.second, time);
+            }
+        }
+        return formattedParser(msg, channel.formattedString(), time);
+    }
+
+    CASIMIR_EXPORT utilities::Logger instantiateLogger(const String& filepath,
+                                                       const std::shared_ptr<StringInterner>& names) {
+        // Written with write(2): line by line on a terminal, by coalesced blocks when piped to a collector
+        std::shared_ptr<ShellLogger> shellLogger = std::make_shared<ShellLogger>(ShellLoggerStream::Stdout);
+        // Errors must be durable right away while the other channels are written by large batches
+        std::shared_ptr<FileLogger> fileLogger = std::make_shared<FileLogger>(
+                filepath, 64 * 1024, std::chrono::milliseconds(1000), std::vector<Uuid>{PrivateLogging::Error});
+
+        LoggerBuilder builder = LoggerBuilder();
+
+        // Adding all the channels that perform parsing (each parser only holds a handle of the channel name)
+        for(const auto& channel : privateChannelNames()) {
+            const InternedString name = names->intern(channel.second);
+            std::function<String(const String&, std::chrono::system_clock::time_point)> parser =
+                    [names, name](const String& msg, std::chrono::system_clock::time_point time) {
+                        return formattedParser(msg, name.str(), time);
+                    };
             builder.registerChannelAt(channel.first, shellLogger, parser);
             builder.registerChannelAt(channel.first, fileLogger, parser);
         }
@@ -107,6 +164,15 @@ namespace Casimir {
         builder.registerChannelAt(PrivateLogging::Raw, shellLogger, [](const String& msg){ return msg; });
         builder.registerChannelAt(PrivateLogging::Raw, fileLogger, [](const String& msg){ return msg; });
 
+        // A failure storm must not saturate the disk nor the terminal
+        for (const Uuid& channel : {PrivateLogging::Error, PrivateLogging::Warning}) {
+            builder.setRepeatCoalescing(channel);
+            builder.setRateLimit(channel, 1000, 1000);
+        }
+
+        // Formatting and I/O are performed by a background thread so that the caller only pays for the enqueue
+        builder.setAsynchronous(4096, LoggerOverflowPolicy::Block);
+
         // Return the constructed Logger
         return builder.create();
     }
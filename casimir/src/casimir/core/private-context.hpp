@@ -4,6 +4,8 @@
 #include "../configuration.hpp"
 #include "../utilities/uuid.hpp"
 #include "../utilities/logger.hpp"
+#include "../utilities/timestamp.hpp"
+#include "../utilities/string_interner.hpp"
 
 namespace Casimir {
 
@@ -12,6 +14,10 @@ namespace Casimir {
      * in any exported header of the project has it will cause error.
      */
     struct PrivateCasimirContext {
+        /**
+         * @brief The names of the context (channel names, ...) stored once (shared with the parsers of the logger)
+         */
+        std::shared_ptr<utilities::StringInterner> names;
         utilities::Logger logger;
     };
 
@@ -42,9 +48,15 @@ namespace Casimir {
         static const utilities::Uuid Raw     = utilities::Uuid(1927683511390330006U, 7972939591306549178U);
     }
 
+    /**
+     * @brief Return the TimestampCache shared by every log record of the library
+     * @return A reference to the process-wide utilities::TimestampCache
+     */
+    CASIMIR_EXPORT utilities::TimestampCache& timestampCache();
+
     /**
      * @brief Private function that return a String that represent the current time formatted for log
-     * @warning This function may no be thread-safe due to the usage of gmtime and gmtime_s (depending on the platform)
+     * @note This function is thread-safe and only formats the date once per second (see utilities::TimestampCache)
      * @return A utilities::String that represent the current formatted time
      */
     CASIMIR_EXPORT utilities::String formattedTime();
@@ -57,13 +69,52 @@ namespace Casimir {
      */
     CASIMIR_EXPORT utilities::String formattedParser(const utilities::String& str, const utilities::String& channelName);
 
+    /**
+     * @brief Return a formatted String from a raw message, a channel name and an already formatted time
+     * @param str The utilities::String that contains the message to be formatted
+     * @param channelName The utilities::String that contains the channel name (small name such as ERROR / WARN)
+     * @param time The formatted time displayed in the header of the message (see formattedTime)
+     * @return The resulting formatted utilities::String
+     */
+    CASIMIR_EXPORT utilities::String formattedParser(const utilities::String& str, const utilities::String& channelName,
+                                                     const utilities::String& time);
+
+    /**
+     * @brief Return a formatted String from a raw message, a channel name and the time the message has been logged at
+     * @param str The utilities::String that contains the message to be formatted
+     * @param channelName The utilities::String that contains the channel name (small name such as ERROR / WARN)
+     * @param time The time displayed in the header of the message
+     * @return The resulting formatted utilities::String
+     */
+    CASIMIR_EXPORT utilities::String formattedParser(const utilities::String& str, const utilities::String& channelName,
+                                                     std::chrono::system_clock::time_point time);
+
+    /**
+     * @brief Return the channels of PrivateLogging that use the formattedParser along with their channel name
+     * @return A list of pairs (channel Uuid, channel name)
+     */
+    CASIMIR_EXPORT const std::vector<std::pair<utilities::Uuid, utilities::String>>& privateChannelNames();
+
+    /**
+     * @brief Format a message as the Logger returned by instantiateLogger would have for the given channel. Messages
+     * of unknown channels use the formatted Uuid as channel name
+     * @param msg The raw message
+     * @param channel The Uuid of the channel the message has been logged into
+     * @param time The formatted time displayed in the header of the message
+     * @return The resulting formatted utilities::String
+     */
+    CASIMIR_EXPORT utilities::String formattedChannelMessage(const utilities::String& msg, const utilities::Uuid& channel,
+                                                             const utilities::String& time);
+
     /**
      * @brief Create a logger based on a filepath where to log. It will use the formattedParser for most of the channels
      * @param filepath The filepath where we want to log the message. If the file doesn't exists will be created.
+     * @param names The StringInterner of the context, where the channel names used by the parsers are interned
      * @throw Casimir::Exception if we cannot open / create or write into the given filepath
      * @return The resulting utilities::Logger
      */
-    CASIMIR_EXPORT utilities::Logger instantiateLogger(const utilities::String& filepath);
+    CASIMIR_EXPORT utilities::Logger instantiateLogger(const utilities::String& filepath,
+                                                       const std::shared_ptr<utilities::StringInterner>& names);
 
 };
 
@@ -0,0 +1,305 @@
+#include "binary_logger.hpp"
+#include "exception.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+namespace Casimir {
+
+    using namespace literals;
+
+    /**
+     * @brief Append the raw bytes of `value` to `output`
+     */
+    template<typename T>
+    static void appendRaw(utilities::String& output, const T& value) {
+        output.append((const char*) &value, sizeof(T));
+    }
+
+    /**
+     * @brief Read the raw bytes of a `T` from `data` if enough bytes remain
+     */
+    template<typename T>
+    static bool readRaw(const char*& data, const char* end, T& value) {
+        if ((cuint) (end - data) < sizeof(T)) return false;
+        memcpy(&value, data, sizeof(T));
+        data += sizeof(T);
+        return true;
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogCodec::appendHeader(utilities::String& output) {
+        output.append(magic(), 8);
+        appendRaw(output, version());
+    }
+
+    CASIMIR_EXPORT cuint utilities::BinaryLogCodec::beginRecord(utilities::String& output, const utilities::Uuid& channel,
+                                                                int64 timestamp) {
+        const cuint position = output.length();
+        appendRaw(output, (std::uint32_t) 0);
+        output.append((const char*) channel.rawData(), 16);
+        appendRaw(output, timestamp);
+        return position;
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogCodec::endRecord(utilities::String& output, cuint recordPosition) {
+        const auto size = (std::uint32_t) (output.length() - recordPosition - sizeof(std::uint32_t));
+        memcpy(&output[recordPosition], &size, sizeof(std::uint32_t));
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogCodec::appendInteger(utilities::String& output, cint value) {
+        output.append(1, (char) Integer);
+        appendRaw(output, (int64) value);
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogCodec::appendUnsigned(utilities::String& output, cuint value) {
+        output.append(1, (char) Unsigned);
+        appendRaw(output, (uint64) value);
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogCodec::appendDouble(utilities::String& output, double value) {
+        output.append(1, (char) Double);
+        appendRaw(output, value);
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogCodec::appendFloat(utilities::String& output, float value) {
+        output.append(1, (char) Float);
+        appendRaw(output, value);
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogCodec::appendPointer(utilities::String& output, const void* ptr) {
+        output.append(1, (char) Pointer);
+        output.append(1, (char) sizeof(void*));
+        appendRaw(output, ptr);
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogCodec::appendText(utilities::String& output, const char* data, cuint length) {
+        output.append(1, (char) Text);
+        appendRaw(output, (std::uint32_t) length);
+        output.append(data, length);
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogCodec::appendArguments(utilities::String& output,
+                                                                   const utilities::LoggerArguments& arguments) {
+        // The arguments are re-encoded one by one since both encodings store the values with different widths
+        const char* data = arguments.data();
+        const char* end = data + arguments.size();
+        while (data != end) {
+            const auto tag = (LoggerArguments::Tag) (ubyte) *data++;
+            bool valid = false;
+            switch (tag) {
+                case LoggerArguments::Integer: {
+                    cint value;
+                    if ((valid = readRaw(data, end, value))) appendInteger(output, value);
+                    break;
+                }
+                case LoggerArguments::Unsigned: {
+                    cuint value;
+                    if ((valid = readRaw(data, end, value))) appendUnsigned(output, value);
+                    break;
+                }
+                case LoggerArguments::Float: {
+                    float value;
+                    if ((valid = readRaw(data, end, value))) appendFloat(output, value);
+                    break;
+                }
+                case LoggerArguments::Double: {
+                    double value;
+                    if ((valid = readRaw(data, end, value))) appendDouble(output, value);
+                    break;
+                }
+                case LoggerArguments::Pointer: {
+                    const void* ptr;
+                    if ((valid = readRaw(data, end, ptr))) appendPointer(output, ptr);
+                    break;
+                }
+                case LoggerArguments::Text: {
+                    cuint length;
+                    if ((valid = readRaw(data, end, length) && length <= (cuint) (end - data))) {
+                        appendText(output, data, length);
+                        data += length;
+                    }
+                    break;
+                }
+            }
+            if (!valid) CASIMIR_THROW_EXCEPTION("InvalidFormat", "Malformed logger arguments");
+        }
+    }
+
+    CASIMIR_EXPORT bool utilities::BinaryLogCodec::renderArguments(const char* data, cuint size, utilities::String& message) {
+        const char* end = data + size;
+        while (data != end) {
+            const ubyte tag = (ubyte) *data++;
+            switch (tag) {
+                case Integer: {
+                    int64 value;
+                    if (!readRaw(data, end, value)) return false;
+                    message.append(String::toString((cint) value));
+                    break;
+                }
+                case Unsigned: { // Rendered as the LoggerChannelAdapter does
+                    uint64 value;
+                    if (!readRaw(data, end, value)) return false;
+                    message.append(String::toString((cint) value));
+                    break;
+                }
+                case Float: {
+                    float value;
+                    if (!readRaw(data, end, value)) return false;
+                    message.append(String::toString(value));
+                    break;
+                }
+                case Double: {
+                    double value;
+                    if (!readRaw(data, end, value)) return false;
+                    message.append(String::toString(value));
+                    break;
+                }
+                case Pointer: {
+                    ubyte pointerSize;
+                    if (!readRaw(data, end, pointerSize) || (cuint) (end - data) < pointerSize) return false;
+                    message.append(String(data, pointerSize).encodeToHex());
+                    data += pointerSize;
+                    break;
+                }
+                case Text: {
+                    std::uint32_t length;
+                    if (!readRaw(data, end, length) || (cuint) (end - data) < length) return false;
+                    message.append(data, length);
+                    data += length;
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    CASIMIR_EXPORT utilities::BinaryLogger::Record::~Record() {
+        BinaryLogCodec::endRecord(m_record, m_position);
+        m_logger->write(m_record);
+    }
+
+    CASIMIR_EXPORT utilities::BinaryLogger::BinaryLogger(const utilities::String& filepath, cuint bufferSize,
+                                                         std::chrono::milliseconds flushInterval)
+        : m_file(filepath, bufferSize, flushInterval) {
+        // Each session starts with a header so that files can be appended by different versions
+        String header;
+        BinaryLogCodec::appendHeader(header);
+        m_file.log(header);
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogger::log(const utilities::String& msg) {
+        logFrom(Uuid(), msg);
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogger::logFrom(const utilities::Uuid& channel, const utilities::String& msg) {
+        String record;
+        record.reserve(msg.length() + 48);
+        const cuint position = BinaryLogCodec::beginRecord(record, channel, BinaryLogCodec::now());
+        BinaryLogCodec::appendText(record, msg.c_str(), msg.length());
+        BinaryLogCodec::endRecord(record, position);
+        m_file.log(record);
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogger::logArguments(const utilities::Uuid& channel,
+                                                              const utilities::LoggerArguments& arguments) {
+        String record;
+        record.reserve(arguments.size() + 48);
+        const cuint position = BinaryLogCodec::beginRecord(record, channel,
+                                                           BinaryLogCodec::timestampOf(arguments.time()));
+        BinaryLogCodec::appendArguments(record, arguments);
+        BinaryLogCodec::endRecord(record, position);
+        m_file.log(record);
+    }
+
+    CASIMIR_EXPORT bool utilities::BinaryLogger::expectsRawMessage() const {
+        return true;
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogger::flush() {
+        m_file.flush();
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogger::write(const utilities::String& record) {
+        m_file.log(record);
+    }
+
+    CASIMIR_EXPORT utilities::BinaryLogReader::BinaryLogReader(const utilities::String& filepath)
+        : m_stream(filepath.c_str(), std::ios_base::in | std::ios_base::binary), m_position(0), m_end(0) {
+        if (!m_stream.is_open()) {
+            const String what = std::system_error(errno, std::system_category(),
+                                                  "Cannot open file " + filepath.str()).what();
+            CASIMIR_THROW_EXCEPTION("SystemException", what);
+        }
+        measure();
+    }
+
+    CASIMIR_EXPORT bool utilities::BinaryLogReader::read(char* data, cuint size) {
+        if (!m_stream.read(data, (std::streamsize) size)) return false;
+        m_position += size;
+        return true;
+    }
+
+    CASIMIR_EXPORT void utilities::BinaryLogReader::measure() {
+        m_stream.seekg(0, std::ios_base::end);
+        const std::streamoff end = m_stream.tellg();
+        m_end = end > 0 ? (cuint) end : 0;
+        m_stream.seekg((std::streamoff) m_position, std::ios_base::beg);
+    }
+
+    CASIMIR_EXPORT bool utilities::BinaryLogReader::remains(cuint size) {
+        if (m_position <= m_end && size <= m_end - m_position) return true;
+        measure();
+        return m_position <= m_end && size <= m_end - m_position;
+    }
+
+    CASIMIR_EXPORT bool utilities::BinaryLogReader::next(utilities::BinaryLogEntry& entry) {
+        while (true) {
+            char prefix[sizeof(std::uint32_t)];
+            if (!read(prefix, sizeof(prefix))) {
+                if (m_stream.gcount() != 0) CASIMIR_THROW_EXCEPTION("InvalidFormat", "Truncated record in the binary log");
+                return false;
+            }
+
+            // Session header
+            if (memcmp(prefix, BinaryLogCodec::magic(), sizeof(prefix)) == 0) {
+                char rest[4 + sizeof(std::uint32_t)];
+                std::uint32_t version;
+                if (!read(rest, sizeof(rest)) || memcmp(rest, BinaryLogCodec::magic() + 4, 4) != 0) {
+                    CASIMIR_THROW_EXCEPTION("InvalidFormat", "Invalid session header in the binary log");
+                }
+                memcpy(&version, rest + 4, sizeof(std::uint32_t));
+                if (version == 0 || version > BinaryLogCodec::version()) {
+                    CASIMIR_THROW_EXCEPTION("InvalidFormat", "Unsupported binary log version " + String::toString((cint) version));
+                }
+                continue;
+            }
+
+            // Record, its size is checked against the rest of the file before anything is allocated
+            std::uint32_t size;
+            memcpy(&size, prefix, sizeof(std::uint32_t));
+            if (size < 16 + sizeof(int64)) {
+                CASIMIR_THROW_EXCEPTION("InvalidFormat", "Invalid record size in the binary log");
+            }
+            if (!remains(size)) {
+                CASIMIR_THROW_EXCEPTION("InvalidFormat", "Truncated record in the binary log");
+            }
+            m_buffer = String('\0', size);
+            if (!read(&m_buffer[0], size)) {
+                CASIMIR_THROW_EXCEPTION("InvalidFormat", "Truncated record in the binary log");
+            }
+
+            const char* data = m_buffer.c_str();
+            entry.channel = Uuid((const ubyte*) data);
+            memcpy(&entry.timestamp, data + 16, sizeof(int64));
+            entry.message = String();
+            if (!BinaryLogCodec::renderArguments(data + 16 + sizeof(int64), size - 16 - sizeof(int64), entry.message)) {
+                CASIMIR_THROW_EXCEPTION("InvalidFormat", "Invalid record arguments in the binary log");
+            }
+            return true;
+        }
+    }
+
+}
@@ -0,0 +1,392 @@
+#ifndef CASIMIR_BINARY_LOGGER_HPP_
+#define CASIMIR_BINARY_LOGGER_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+
+#include "../casimir.hpp"
+#include "string.hpp"
+#include "uuid.hpp"
+#include "logger.hpp"
+
+namespace Casimir {
+
+    namespace utilities {
+
+        /**
+         * @brief Encoding and decoding of the compact binary log format. A binary log file is a sequence of session
+         * headers (the 8 bytes `CASIMIRB` followed by an unsigned 32-bit version) and records. Each record is made of:
+         *   - an unsigned 32-bit size (number of bytes following the size field)
+         *   - the 16 bytes of the channel Uuid
+         *   - an int64 timestamp (microseconds since epoch, UTC)
+         *   - the arguments, each made of a one byte tag followed by the raw value
+         * @note Values are stored with the native endianness of the producer
+         */
+        class BinaryLogCodec {
+        public:
+            /**
+             * @brief Tag written before each argument of a record
+             */
+            enum ArgumentTag : ubyte {
+                Integer  = 'i', // int64
+                Unsigned = 'u', // uint64
+                Float    = 'f', // float (since version 2)
+                Double   = 'd', // double
+                Pointer  = 'p', // ubyte size followed by the bytes of the pointer
+                Text     = 's'  // unsigned 32-bit length followed by the bytes of the String
+            };
+
+            /**
+             * @brief The magic bytes of a session header
+             * @return A pointer to the 8 magic bytes
+             */
+            inline static const char* magic() {
+                return "CASIMIRB";
+            }
+
+            /**
+             * @brief The version of the binary format written by the current library (the files of the previous
+             * versions can still be read)
+             * @return the version of the binary format
+             */
+            inline static constexpr std::uint32_t version() {
+                return 2;
+            }
+
+            /**
+             * @brief Append a session header to `output`
+             * @param output the String the header is appended to
+             */
+            CASIMIR_EXPORT static void appendHeader(String& output);
+
+            /**
+             * @brief Start a new record at the end of `output`. The record must be closed with endRecord
+             * @param output the String the record is appended to
+             * @param channel the Uuid of the channel of the record
+             * @param timestamp the number of microseconds since epoch
+             * @return the position of the record in `output`
+             */
+            CASIMIR_EXPORT static cuint beginRecord(String& output, const Uuid& channel, int64 timestamp);
+
+            /**
+             * @brief Close the record started at `recordPosition` by writing its size
+             * @param output the String containing the record
+             * @param recordPosition the position returned by beginRecord
+             */
+            CASIMIR_EXPORT static void endRecord(String& output, cuint recordPosition);
+
+            /**
+             * @brief Append an Integer argument to the record being written in `output`
+             * @param output the String containing the record
+             * @param value the integer to be appended
+             */
+            CASIMIR_EXPORT static void appendInteger(String& output, cint value);
+            /**
+             * @brief Append an Unsigned argument to the record being written in `output`
+             * @param output the String containing the record
+             * @param value the unsigned integer to be appended
+             */
+            CASIMIR_EXPORT static void appendUnsigned(String& output, cuint value);
+            /**
+             * @brief Append a Double argument to the record being written in `output`
+             * @param output the String containing the record
+             * @param value the floating value to be appended
+             */
+            CASIMIR_EXPORT static void appendDouble(String& output, double value);
+            /**
+             * @brief Append a Float argument to the record being written in `output`
+             * @param output the String containing the record
+             * @param value the floating value to be appended
+             */
+            CASIMIR_EXPORT static void appendFloat(String& output, float value);
+            /**
+             * @brief Append a Pointer argument to the record being written in `output`
+             * @param output the String containing the record
+             * @param ptr the pointer to be appended
+             */
+            CASIMIR_EXPORT static void appendPointer(String& output, const void* ptr);
+            /**
+             * @brief Append a Text argument to the record being written in `output`
+             * @param output the String containing the record
+             * @param data the bytes of the text
+             * @param length the number of bytes of the text
+             */
+            CASIMIR_EXPORT static void appendText(String& output, const char* data, cuint length);
+            /**
+             * @brief Append each of the arguments captured by a LoggerChannelAdapter with its own type
+             * @param output the String containing the record
+             * @param arguments the captured arguments
+             * @throw Casimir::Exception if the arguments are malformed (truncated value or unknown type)
+             */
+            CASIMIR_EXPORT static void appendArguments(String& output, const LoggerArguments& arguments);
+
+            /**
+             * @brief Render the arguments of a record as the text the LoggerChannelAdapter would have produced
+             * @param data the bytes of the arguments
+             * @param size the number of bytes of the arguments
+             * @param message the String the text is appended to
+             * @return false if the arguments are malformed
+             */
+            CASIMIR_EXPORT static bool renderArguments(const char* data, cuint size, String& message);
+
+            /**
+             * @brief Return the current time in the unit used by the records
+             * @return the number of microseconds since epoch
+             */
+            inline static int64 now() {
+                return timestampOf(std::chrono::system_clock::now());
+            }
+
+            /**
+             * @brief Convert a time point to the unit used by the records
+             * @param time the time point to be converted
+             * @return the number of microseconds since epoch
+             */
+            inline static int64 timestampOf(std::chrono::system_clock::time_point time) {
+                return (int64) std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+            }
+        };
+
+        /**
+         * @brief Logger channel that stores the records in the compact binary format (see BinaryLogCodec) instead
+         * of formatting them. The file can be expanded back into the text layout with the `casimir-log-decoder` tool
+         * @note This class is thread-safe
+         */
+        class BinaryLogger : public AbstractLoggerChannel {
+            CASIMIR_DISABLE_COPY_MOVE(BinaryLogger);
+        private:
+            FileLogger m_file;
+
+        public:
+            /**
+             * @brief Record that captures raw arguments and write them into the BinaryLogger when destroyed
+             */
+            class Record {
+                CASIMIR_DISABLE_COPY(Record)
+                friend class BinaryLogger;
+            private:
+                BinaryLogger* m_logger;
+                String m_record;
+                cuint m_position;
+
+                /**
+                 * @brief Private constructor of Record (see BinaryLogger::record)
+                 * @param logger the BinaryLogger the record is written into
+                 * @param channel the Uuid of the channel of the record
+                 */
+                inline Record(BinaryLogger* logger, const Uuid& channel)
+                    : m_logger(logger), m_position(BinaryLogCodec::beginRecord(m_record, channel, BinaryLogCodec::now())) {}
+
+            public:
+                /**
+                 * @brief Destructor of the Record. The record is written during the destruction
+                 */
+                CASIMIR_EXPORT ~Record();
+
+                /**
+                 * @brief Append a Text argument to the record
+                 * @param str the String to be appended
+                 * @return A self-reference
+                 */
+                inline Record& operator<<(const String& str) {
+                    BinaryLogCodec::appendText(m_record, str.c_str(), str.length());
+                    return *this;
+                }
+
+                /**
+                 * @brief Append a C-Style string as a Text argument to the record
+                 * @param msg the C-Style string to be appended
+                 * @return A self-reference
+                 */
+                inline Record& operator<<(const char* msg) {
+                    return operator<<(String(msg));
+                }
+
+                /**
+                 * @brief Append an StringSerializable object as a Text argument to the record
+                 * @param stringSerializable the stringSerializable object (that will be convert to String)
+                 * @return A self-reference
+                 */
+                inline Record& operator<<(const StringSerializable& stringSerializable) {
+                    return operator<<(stringSerializable.toString());
+                }
+
+                /**
+                 * @brief Append an Integer argument to the record
+                 * @param value the integer to be appended
+                 * @return A self-reference
+                 */
+                inline Record& operator<<(cint value) {
+                    BinaryLogCodec::appendInteger(m_record, value);
+                    return *this;
+                }
+
+                /**
+                 * @brief Append an Unsigned argument to the record
+                 * @param value the unsigned integer to be appended
+                 * @return A self-reference
+                 */
+                inline Record& operator<<(cuint value) {
+                    BinaryLogCodec::appendUnsigned(m_record, value);
+                    return *this;
+                }
+
+                /**
+                 * @brief Append a Double argument to the record
+                 * @param value the double to be appended
+                 * @return A self-reference
+                 */
+                inline Record& operator<<(double value) {
+                    BinaryLogCodec::appendDouble(m_record, value);
+                    return *this;
+                }
+
+                /**
+                 * @brief Append a Float argument to the record
+                 * @param value the float to be appended
+                 * @return A self-reference
+                 */
+                inline Record& operator<<(float value) {
+                    BinaryLogCodec::appendFloat(m_record, value);
+                    return *this;
+                }
+
+                /**
+                 * @brief Append a Pointer argument to the record
+                 * @param ptr the pointer to be appended
+                 * @return A self-reference
+                 */
+                inline Record& operator<<(const void* ptr) {
+                    BinaryLogCodec::appendPointer(m_record, ptr);
+                    return *this;
+                }
+            };
+
+            /**
+             * @brief Construct a BinaryLogger that appends records to `filepath`
+             * @param filepath the file path of the binary log
+             * @param bufferSize the size of the user-space buffer (see FileLogger)
+             * @param flushInterval the maximum time a record stays in the buffer (see FileLogger)
+             * @throw Casimir::Exception if we cannot open / create or write into the given filepath
+             */
+            CASIMIR_EXPORT explicit BinaryLogger(const String& filepath, cuint bufferSize = 64 * 1024,
+                                                 std::chrono::milliseconds flushInterval = std::chrono::milliseconds(1000));
+
+            /**
+             * @brief Start a record with raw arguments into the given channel
+             * @param channel the Uuid of the channel the record belongs to
+             * @return The Record capturing the arguments
+             */
+            inline Record record(const Uuid& channel) {
+                return Record(this, channel);
+            }
+
+            /**
+             * @brief Store `msg` as a single text argument with the NIL channel
+             * @param msg the message to be stored
+             */
+            CASIMIR_EXPORT void log(const String& msg) override;
+
+            /**
+             * @brief Store `msg` as a single text argument
+             * @param channel the Uuid of the channel the message has been logged into
+             * @param msg the message to be stored
+             */
+            CASIMIR_EXPORT void logFrom(const Uuid& channel, const String& msg) override;
+
+            /**
+             * @brief Store the arguments of a message logged through a Logger, each one with its own type, so that
+             * they are only formatted by the decoder
+             * @param channel the Uuid of the channel the message has been logged into
+             * @param arguments the captured arguments of the message
+             */
+            CASIMIR_EXPORT void logArguments(const Uuid& channel, const LoggerArguments& arguments) override;
+
+            /**
+             * @brief The BinaryLogger receives the typed arguments of the messages instead of the parsed text (see
+             * BinaryLogger::logArguments)
+             * @return true
+             */
+            CASIMIR_EXPORT bool expectsRawMessage() const override;
+
+            /**
+             * @brief Write every buffered record to the file
+             */
+            CASIMIR_EXPORT void flush();
+
+            /**
+             * @brief Write an already encoded record (see BinaryLogCodec)
+             * @param record the bytes of the record
+             */
+            CASIMIR_EXPORT void write(const String& record);
+        };
+
+        /**
+         * @brief A record decoded from a binary log file
+         */
+        struct BinaryLogEntry {
+            Uuid channel;
+            int64 timestamp;
+            String message;
+
+            /**
+             * @brief Convert the timestamp of the entry to a time point
+             * @return the time point of the entry
+             */
+            inline std::chrono::system_clock::time_point time() const {
+                return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        std::chrono::microseconds(timestamp)));
+            }
+        };
+
+        /**
+         * @brief Sequential reader of a binary log file
+         */
+        class BinaryLogReader {
+            CASIMIR_DISABLE_COPY_MOVE(BinaryLogReader);
+        private:
+            std::ifstream m_stream;
+            String m_buffer;
+            cuint m_position; // Number of bytes read from the file
+            cuint m_end;      // Size of the file when last measured
+
+            /**
+             * @brief Read `size` bytes of the file into `data`, keeping track of the current position
+             * @return false if the end of the file has been reached before
+             */
+            CASIMIR_EXPORT bool read(char* data, cuint size);
+
+            /**
+             * @brief Measure the size of the file again (the file may grow while it is read)
+             */
+            CASIMIR_EXPORT void measure();
+
+            /**
+             * @brief Whether or not `size` bytes remain to be read in the file (measured again if the file has grown
+             * since it was opened)
+             */
+            CASIMIR_EXPORT bool remains(cuint size);
+
+        public:
+            /**
+             * @brief Open the binary log file `filepath`
+             * @param filepath the path to the binary log
+             * @throw Casimir::Exception if the file cannot be opened
+             */
+            CASIMIR_EXPORT explicit BinaryLogReader(const String& filepath);
+
+            /**
+             * @brief Decode the next record of the file
+             * @param entry the decoded record
+             * @throw Casimir::Exception if the file is corrupted
+             * @return false when the end of the file is reached
+             */
+            CASIMIR_EXPORT bool next(BinaryLogEntry& entry);
+        };
+
+    }
+
+}
+
+#endif
@@ -1,27 +1,268 @@
 #include "cmutex.hpp"
 #include "exception.hpp"
+#include "string_interner.hpp"
+
+#include <algorithm>
+#include <string>
 
 namespace Casimir {
 
+    /**
+     * @brief Number of times a waiting thread checks its ticket before going to sleep
+     */
+    static constexpr cuint s_spinCount = 256;
+
+    /**
+     * @brief Maximum number of call sites recorded for each profiled Mutex
+     */
+    static constexpr cuint s_callSiteCount = 16;
+
+    /**
+     * @brief Statistics of a profiled Mutex. They are only written by the thread holding the lock, hence the relaxed
+     * loads and stores (the atomics are only there so that the LockProfiler can read them at any time)
+     */
+    class utilities::__LockStatistics {
+    public:
+        struct CallSite {
+            std::atomic<const char*> file{nullptr};
+            std::atomic<int> line{0};
+            std::atomic<cuint> acquisitions{0};
+            std::atomic<cuint> wait{0};
+        };
+
+        const InternedString name; // Many locks share the same name (one per logger instance, ...)
+        std::atomic<cuint> acquisitions{0};
+        std::atomic<cuint> contendedAcquisitions{0};
+        std::atomic<cuint> totalWait{0};
+        std::atomic<cuint> maxWait{0};
+        std::atomic<cuint> totalHold{0};
+        std::atomic<cuint> maxHold{0};
+        CallSite sites[s_callSiteCount];
+        std::atomic<cuint> siteCount{0};
+
+        explicit __LockStatistics(const String& name) : name(StringInterner::global().intern(name)) {}
+
+        static void add(std::atomic<cuint>& value, cuint amount) {
+            value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        static void raise(std::atomic<cuint>& value, cuint candidate) {
+            if (value.load(std::memory_order_relaxed) < candidate) value.store(candidate, std::memory_order_relaxed);
+        }
+
+        void recordAcquisition(cuint wait, bool contended, const char* file, int line) {
+            add(acquisitions, 1);
+            if (contended) {
+                add(contendedAcquisitions, 1);
+                add(totalWait, wait);
+                raise(maxWait, wait);
+            }
+
+            // The call sites are identified by the address of the file name (a string literal) and the line
+            const cuint count = siteCount.load(std::memory_order_relaxed);
+            for (cuint i = 0; i < count; ++i) {
+                CallSite& site = sites[i];
+                if (site.line.load(std::memory_order_relaxed) == line &&
+                    site.file.load(std::memory_order_relaxed) == file) {
+                    add(site.acquisitions, 1);
+                    add(site.wait, wait);
+                    return;
+                }
+            }
+            if (count < s_callSiteCount) {
+                CallSite& site = sites[count];
+                site.file.store(file, std::memory_order_relaxed);
+                site.line.store(line, std::memory_order_relaxed);
+                site.acquisitions.store(1, std::memory_order_relaxed);
+                site.wait.store(wait, std::memory_order_relaxed);
+                siteCount.store(count + 1, std::memory_order_release);
+            }
+        }
+
+        void recordRelease(cuint hold) {
+            add(totalHold, hold);
+            raise(maxHold, hold);
+        }
+
+        utilities::LockContention snapshot() const {
+            utilities::LockContention contention;
+            contention.name = name.str();
+            contention.acquisitions = acquisitions.load(std::memory_order_relaxed);
+            contention.contendedAcquisitions = contendedAcquisitions.load(std::memory_order_relaxed);
+            contention.totalWait = std::chrono::nanoseconds(totalWait.load(std::memory_order_relaxed));
+            contention.maxWait = std::chrono::nanoseconds(maxWait.load(std::memory_order_relaxed));
+            contention.totalHold = std::chrono::nanoseconds(totalHold.load(std::memory_order_relaxed));
+            contention.maxHold = std::chrono::nanoseconds(maxHold.load(std::memory_order_relaxed));
+
+            // The hottest site is the one that waited the most, or the most frequent one if nobody waited
+            const CallSite* hottest = nullptr;
+            const cuint count = siteCount.load(std::memory_order_acquire);
+            for (cuint i = 0; i < count; ++i) {
+                const CallSite& site = sites[i];
+                if (hottest == nullptr ||
+                    site.wait.load(std::memory_order_relaxed) > hottest->wait.load(std::memory_order_relaxed) ||
+                    (site.wait.load(std::memory_order_relaxed) == hottest->wait.load(std::memory_order_relaxed) &&
+                     site.acquisitions.load(std::memory_order_relaxed) >
+                     hottest->acquisitions.load(std::memory_order_relaxed))) {
+                    hottest = &site;
+                }
+            }
+            if (hottest != nullptr) {
+                const char* file = hottest->file.load(std::memory_order_relaxed);
+                contention.hottestSite = file == nullptr || *file == '\0' ? "<unknown>" : file;
+                contention.hottestSite.append(":");
+                contention.hottestSite.append(std::to_string(hottest->line.load(std::memory_order_relaxed)).c_str());
+            }
+            return contention;
+        }
+    };
+
+    static std::atomic<bool> s_lockProfilerEnabled(true);
+
+    /**
+     * @brief Registry of the statistics of the profiled Mutex instances (constructed on first use so that static
+     * Mutex instances can be profiled as well)
+     */
+    struct LockRegistry {
+        std::mutex mutex;
+        std::vector<std::weak_ptr<utilities::__LockStatistics>> statistics;
+    };
+
+    static LockRegistry& lockRegistry() {
+        static LockRegistry* registry = new LockRegistry(); // Never destroyed, Mutex instances may outlive it
+        return *registry;
+    }
+
+    CASIMIR_EXPORT void utilities::LockProfiler::setEnabled(bool enabled) {
+        s_lockProfilerEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    CASIMIR_EXPORT bool utilities::LockProfiler::isEnabled() {
+        return s_lockProfilerEnabled.load(std::memory_order_relaxed);
+    }
+
+    CASIMIR_EXPORT std::vector<utilities::LockContention> utilities::LockProfiler::snapshot() {
+        std::vector<LockContention> contentions;
+        {
+            LockRegistry& registry = lockRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            auto it = registry.statistics.begin();
+            while (it != registry.statistics.end()) {
+                const std::shared_ptr<__LockStatistics> statistics = it->lock();
+                if (statistics == nullptr) {
+                    it = registry.statistics.erase(it);
+                    continue;
+                }
+                contentions.push_back(statistics->snapshot());
+                ++it;
+            }
+        }
+        std::stable_sort(contentions.begin(), contentions.end(), [](const LockContention& a, const LockContention& b) {
+            return a.totalWait > b.totalWait;
+        });
+        return contentions;
+    }
+
     CASIMIR_EXPORT utilities::Mutex::Mutex()
+        : m_nextTicket(0), m_servingTicket(0), m_owner(std::thread::id()), m_parked(0)
     {
 
     }
 
-    CASIMIR_EXPORT bool utilities::Mutex::tryAquireLock() {
-        // Retrieve the id of the thread
-        const std::thread::id id = std::this_thread::get_id();
+    CASIMIR_EXPORT utilities::Mutex::Mutex(const String& name)
+        : m_nextTicket(0), m_servingTicket(0), m_owner(std::thread::id()), m_parked(0),
+          m_statistics(std::make_shared<__LockStatistics>(name))
+    {
+        LockRegistry& registry = lockRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.statistics.push_back(m_statistics);
+    }
+
+    void utilities::Mutex::waitForTicket(cuint ticket) {
+        // The lock is usually held for a short time, spinning avoids the cost of a sleep
+        for (cuint i = 0; i < s_spinCount; ++i) {
+            if (m_servingTicket.load(std::memory_order_acquire) == ticket) return;
+            if (i >= s_spinCount / 2) std::this_thread::yield();
+        }
+
+        // Announce that we are going to sleep before checking one last time (see releaseLock)
+        m_parked.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(m_parkMutex);
+            m_parkCondition.wait(lock, [this, ticket]() { return m_servingTicket.load() == ticket; });
+        }
+        m_parked.fetch_sub(1);
+    }
+
+    bool utilities::Mutex::tryTakeLock() {
+        // The lock is free only when no ticket is waiting to be served
+        cuint ticket = m_servingTicket.load(std::memory_order_acquire);
+        if (!m_nextTicket.compare_exchange_strong(ticket, ticket + 1, std::memory_order_acquire)) {
+            return false;
+        }
+        m_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        return true;
+    }
+
+    void utilities::Mutex::recordAcquisition(std::chrono::steady_clock::time_point waitStart, const char* file,
+                                             int line) {
+        if (!s_lockProfilerEnabled.load(std::memory_order_relaxed)) {
+            m_acquiredAt = std::chrono::steady_clock::time_point();
+            return;
+        }
+        m_acquiredAt = std::chrono::steady_clock::now();
+
+        // The clock is only read before waiting when the lock wasn't free
+        const bool contended = waitStart != std::chrono::steady_clock::time_point();
+        const cuint wait = contended ? (cuint) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                m_acquiredAt - waitStart).count() : 0;
+        m_statistics->recordAcquisition(wait, contended, file, line);
+    }
+
+    CASIMIR_EXPORT bool utilities::Mutex::tryAquireLock(const char* file, int line) {
+        if (m_owner.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+            return true;
+        }
+        if (!tryTakeLock()) {
+            return false;
+        }
+        if (m_statistics != nullptr) recordAcquisition(std::chrono::steady_clock::time_point(), file, line);
+        return true;
+    }
+
+    CASIMIR_EXPORT bool utilities::Mutex::tryAcquireLockFor(std::chrono::nanoseconds timeout, const char* file,
+                                                            int line) {
+        if (m_owner.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+            return true;
+        }
+        if (tryTakeLock()) {
+            if (m_statistics != nullptr) recordAcquisition(std::chrono::steady_clock::time_point(), file, line);
+            return true;
+        }
 
-        // We lock because we do not expect the m_queue to change while performing the search
-        // could lead to undefined behavior
-        m_internalOperation.lock();
-        const bool success = m_queue.empty() || *m_queue.begin() == id;
-        if(success && m_queue.empty()) {
-            m_queue.insert(m_queue.begin(), id);
+        const auto waitStart = std::chrono::steady_clock::now();
+        const auto deadline = waitStart + timeout;
+        bool success = false;
+        for (cuint i = 1; i < s_spinCount && !success; ++i) {
+            success = tryTakeLock();
+            if (i >= s_spinCount / 2) std::this_thread::yield();
         }
-        m_internalOperation.unlock();
 
-        // Then simply return the success value
+        // Taking a ticket cannot be undone, hence the lock is only taken once nobody is waiting for it anymore
+        if (!success) {
+            m_parked.fetch_add(1);
+            {
+                std::unique_lock<std::mutex> lock(m_parkMutex);
+                while (!(success = tryTakeLock())) {
+                    if (m_parkCondition.wait_until(lock, deadline) == std::cv_status::timeout) {
+                        success = tryTakeLock();
+                        break;
+                    }
+                }
+            }
+            m_parked.fetch_sub(1);
+        }
+        if (success && m_statistics != nullptr) recordAcquisition(waitStart, file, line);
         return success;
     }
 
@@ -29,61 +270,162 @@ namespace Casimir {
         // Retrieve the id of the thread
         const std::thread::id id = std::this_thread::get_id();
 
-        // We lock because we do not expect the m_queue to change while performing the search
-        // could lead to undefined behavior
-        m_internalOperation.lock();
-        const bool success = !m_queue.empty() && *m_queue.begin() == id;
-        if(success) {
-            m_queue.pop_front();
-        }
-        m_internalOperation.unlock();
-
         // If no success throw exception
-        if(!success) {
+        if (m_owner.load(std::memory_order_relaxed) != id) {
             CASIMIR_THROW_EXCEPTION("InvalidRequest", "Cannot release the Mutex since you don't actually own the lock");
         }
+        if (m_statistics != nullptr && m_acquiredAt != std::chrono::steady_clock::time_point()) {
+            m_statistics->recordRelease((cuint) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - m_acquiredAt).count());
+        }
+        m_owner.store(std::thread::id(), std::memory_order_relaxed);
+        m_servingTicket.fetch_add(1);
+
+        // Either the sleeping threads are seen here or they see the new ticket before going to sleep
+        if (m_parked.load() != 0) {
+            std::lock_guard<std::mutex> lock(m_parkMutex);
+            m_parkCondition.notify_all();
+        }
     }
 
-    CASIMIR_EXPORT void utilities::Mutex::acquireLock() {
+    CASIMIR_EXPORT void utilities::Mutex::acquireLock(const char* file, int line) {
         // Retrieve the id of the thread
         const std::thread::id id = std::this_thread::get_id();
+        if (m_owner.load(std::memory_order_relaxed) == id) {
+            return;
+        }
 
-        while(true) {
-            // We lock because we do not expect the m_queue to change while performing the search
-            // could lead to undefined behavior
-            m_internalOperation.lock();
-            auto it = std::find_if(m_queue.begin(), m_queue.end(), [id](const std::thread::id& cid) { return cid == id; });
+        const cuint ticket = m_nextTicket.fetch_add(1, std::memory_order_relaxed);
+        std::chrono::steady_clock::time_point waitStart;
+        if (m_servingTicket.load(std::memory_order_acquire) != ticket) {
+            if (m_statistics != nullptr) waitStart = std::chrono::steady_clock::now();
+            waitForTicket(ticket);
+        }
+        m_owner.store(id, std::memory_order_relaxed);
+        if (m_statistics != nullptr) recordAcquisition(waitStart, file, line);
+    }
 
-            // Determine the position
-            cuint position = std::distance(it, m_queue.begin());
+    CASIMIR_EXPORT bool utilities::Mutex::ownLock() {
+        return m_owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
 
-            // If the object has not been found
-            if(it == m_queue.end()) {
-                m_queue.insert(it, id);
-            }
+    /**
+     * @brief Round-robin index given to each thread the first time it takes a SharedMutex in shared mode
+     */
+    static std::atomic<cuint> s_nextSlotIndex(0);
+    static thread_local cuint s_slotIndex = 0; // 0 until the index is given (index + 1 afterward)
 
-            // Release the lock as we do not longer require to have the lock
-            m_internalOperation.unlock();
+    static inline cuint threadSlotIndex() {
+        if (s_slotIndex == 0) {
+            s_slotIndex = s_nextSlotIndex.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+        return s_slotIndex - 1;
+    }
 
-            // Evaluate the position in the list
-            if(position == 0) {
-                break;
-            }
+    /**
+     * @brief Number of reader slots of a SharedMutex (power of two)
+     */
+    static cuint sharedMutexSlotCount() {
+        const cuint threads = std::max<cuint>(std::thread::hardware_concurrency(), 1);
+        cuint count = 1;
+        while (count < threads && count < 64) count <<= 1U;
+        return count;
+    }
+
+    CASIMIR_EXPORT utilities::SharedMutex::SharedMutex()
+        : m_slotMask(sharedMutexSlotCount() - 1), m_slots(new ReaderSlot[m_slotMask + 1]), m_writer(false),
+          m_writerId(std::thread::id()), m_parked(0), m_writerParked(false)
+    {
+
+    }
+
+    utilities::SharedMutex::ReaderSlot& utilities::SharedMutex::slot() {
+        return m_slots[threadSlotIndex() & m_slotMask];
+    }
+
+    void utilities::SharedMutex::leave(ReaderSlot& readerSlot) {
+        // Either the parked writer is seen here or it sees the drained slot before going to sleep
+        if (readerSlot.count.fetch_sub(1) == 1 && m_writer.load() && m_writerParked.load()) {
+            std::lock_guard<std::mutex> lock(m_parkMutex);
+            m_writerCondition.notify_one();
         }
     }
 
-    CASIMIR_EXPORT bool utilities::Mutex::ownLock() {
-        // Retrieve the id of the thread
-        const std::thread::id id = std::this_thread::get_id();
+    void utilities::SharedMutex::waitForReaders(ReaderSlot& readerSlot) {
+        for (cuint i = 0; i < s_spinCount; ++i) {
+            if (readerSlot.count.load(std::memory_order_acquire) == 0) return;
+            if (i >= s_spinCount / 2) std::this_thread::yield();
+        }
+
+        // Announce that we are going to sleep before checking one last time (see leave)
+        m_writerParked.store(true);
+        {
+            std::unique_lock<std::mutex> lock(m_parkMutex);
+            m_writerCondition.wait(lock, [&readerSlot]() { return readerSlot.count.load() == 0; });
+        }
+        m_writerParked.store(false);
+    }
 
-        // We lock because we do not expect the m_queue to change while performing the search
-        // could lead to undefined behavior
-        m_internalOperation.lock();
-        const bool success = !m_queue.empty() && *m_queue.begin() == id;
-        m_internalOperation.unlock();
+    void utilities::SharedMutex::waitForWriter() {
+        for (cuint i = 0; i < s_spinCount; ++i) {
+            if (!m_writer.load(std::memory_order_acquire)) return;
+            if (i >= s_spinCount / 2) std::this_thread::yield();
+        }
 
-        return success;
+        // Announce that we are going to sleep before checking one last time (see releaseLock)
+        m_parked.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(m_parkMutex);
+            m_parkCondition.wait(lock, [this]() { return !m_writer.load(); });
+        }
+        m_parked.fetch_sub(1);
+    }
+
+    CASIMIR_EXPORT void utilities::SharedMutex::acquireSharedLock() {
+        while (!tryAcquireSharedLock()) {
+            waitForWriter();
+        }
     }
 
+    CASIMIR_EXPORT bool utilities::SharedMutex::tryAcquireSharedLock() {
+        // Either the writer sees our counter or we see its flag (both sequentially consistent)
+        ReaderSlot& readerSlot = slot();
+        readerSlot.count.fetch_add(1);
+        if (!m_writer.load()) {
+            return true;
+        }
+        leave(readerSlot);
+        return false;
+    }
+
+    CASIMIR_EXPORT void utilities::SharedMutex::releaseSharedLock() {
+        leave(slot());
+    }
+
+    CASIMIR_EXPORT void utilities::SharedMutex::acquireLock() {
+        m_writerMutex.lock();
+        m_writer.store(true);
+
+        // Wait for the readers that got in before the flag was raised
+        for (cuint i = 0; i <= m_slotMask; ++i) {
+            waitForReaders(m_slots[i]);
+        }
+        m_writerId.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    }
+
+    CASIMIR_EXPORT void utilities::SharedMutex::releaseLock() {
+        if (m_writerId.load(std::memory_order_relaxed) != std::this_thread::get_id()) {
+            CASIMIR_THROW_EXCEPTION("InvalidRequest", "Cannot release the SharedMutex since you don't actually own the lock");
+        }
+        m_writerId.store(std::thread::id(), std::memory_order_relaxed);
+        m_writer.store(false);
+
+        // Either the sleeping readers are seen here or they see the lowered flag before going to sleep
+        if (m_parked.load() != 0) {
+            std::lock_guard<std::mutex> lock(m_parkMutex);
+            m_parkCondition.notify_all();
+        }
+        m_writerMutex.unlock();
+    }
 
 };
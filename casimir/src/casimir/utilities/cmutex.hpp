@@ -3,24 +3,115 @@
 
 #include <mutex>
 #include <atomic>
-#include <list>
-#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <thread>
+#include <memory>
+#include <vector>
 
 #include "../casimir.hpp"
+#include "string.hpp"
+
+/**
+ * @brief File and line of the caller, used as default arguments of the Mutex functions to record the call site of
+ * the acquisitions (empty when the compiler doesn't provide the builtins)
+ */
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1926)
+#define CASIMIR_CALL_SITE_FILE __builtin_FILE()
+#define CASIMIR_CALL_SITE_LINE __builtin_LINE()
+#else
+#define CASIMIR_CALL_SITE_FILE ""
+#define CASIMIR_CALL_SITE_LINE 0
+#endif
 
 namespace Casimir {
 
         namespace utilities {
 
+            class __LockStatistics;
+
+            /**
+             * @brief Contention statistics of a profiled Mutex (see LockProfiler)
+             */
+            struct LockContention {
+                String name;
+                cuint acquisitions;
+                cuint contendedAcquisitions;
+                std::chrono::nanoseconds totalWait;
+                std::chrono::nanoseconds maxWait;
+                std::chrono::nanoseconds totalHold;
+                std::chrono::nanoseconds maxHold;
+
+                /**
+                 * @brief The call site (`file:line`) that waited the longest for the lock in total
+                 */
+                String hottestSite;
+            };
+
+            /**
+             * @brief Registry of the profiled Mutex instances. A Mutex is profiled when it is given a name, the other
+             * ones never pay for the instrumentation
+             */
+            class LockProfiler {
+            public:
+                /**
+                 * @brief Enable or disable the collection of the statistics of every profiled Mutex (enabled by
+                 * default)
+                 * @param enabled whether or not the statistics are collected
+                 */
+                CASIMIR_EXPORT static void setEnabled(bool enabled);
+
+                /**
+                 * @brief Whether or not the statistics are collected
+                 * @return the result of the above check
+                 */
+                CASIMIR_EXPORT static bool isEnabled();
+
+                /**
+                 * @brief Return the statistics of every profiled Mutex still alive, the most contended first (total
+                 * wait time)
+                 * @return the statistics of the profiled Mutex instances
+                 */
+                CASIMIR_EXPORT static std::vector<LockContention> snapshot();
+            };
+
             /**
-             * @brief Mutex class defines a complex mutex behavior that use queue for lock and release operations
+             * @brief Mutex class defines a FIFO-fair mutex (ticket lock) owned by a single thread. A waiting thread
+             * spins for a short while and then sleeps until its ticket is served
              */
             class Mutex {
                 CASIMIR_DISABLE_COPY_MOVE(Mutex);
             private:
-                std::mutex m_internalOperation;
-                std::list<std::thread::id> m_queue;
+                // The tickets are unsigned so that they wrap around (uint32 is signed in this tree)
+                alignas(64) std::atomic<cuint> m_nextTicket;
+                alignas(64) std::atomic<cuint> m_servingTicket;
+                std::atomic<std::thread::id> m_owner;
+                std::atomic<cuint> m_parked;
+                std::mutex m_parkMutex;
+                std::condition_variable m_parkCondition;
+
+                std::shared_ptr<__LockStatistics> m_statistics;
+                std::chrono::steady_clock::time_point m_acquiredAt;
+
+                /**
+                 * @brief Block the thread until `ticket` is served
+                 * @param ticket the ticket taken by the thread
+                 */
+                void waitForTicket(cuint ticket);
+
+                /**
+                 * @brief Take the lock if it is free (the caller doesn't own it)
+                 * @return whether or not the lock has been acquired
+                 */
+                bool tryTakeLock();
+
+                /**
+                 * @brief Record an acquisition of the lock by the current thread into the statistics
+                 * @param waitStart the time at which the thread started waiting (epoch if it didn't wait)
+                 * @param file the file of the call site
+                 * @param line the line of the call site
+                 */
+                void recordAcquisition(std::chrono::steady_clock::time_point waitStart, const char* file, int line);
 
             public:
                 /**
@@ -28,11 +119,33 @@ namespace Casimir {
                  */
                 CASIMIR_EXPORT Mutex();
 
+                /**
+                 * @brief Constructor of a profiled Mutex. The acquisition count, the wait and hold times and the call
+                 * sites are recorded (see LockProfiler)
+                 * @param name the name reported by the LockProfiler
+                 */
+                CASIMIR_EXPORT explicit Mutex(const String& name);
+
                 /**
                  * @brief acquire the lock if free otherwise do nothing
+                 * @param file the file of the call site (recorded by a profiled Mutex)
+                 * @param line the line of the call site (recorded by a profiled Mutex)
                  * @return the success of the operation describe above
                  */
-                CASIMIR_EXPORT bool tryAquireLock();
+                CASIMIR_EXPORT bool tryAquireLock(const char* file = CASIMIR_CALL_SITE_FILE,
+                                                  int line = CASIMIR_CALL_SITE_LINE);
+
+                /**
+                 * @brief acquire the lock if it becomes free before `timeout` expires
+                 * @note A thread waiting with a timeout never overtakes the threads blocked in acquireLock
+                 * @param timeout the maximum time spent waiting for the lock
+                 * @param file the file of the call site (recorded by a profiled Mutex)
+                 * @param line the line of the call site (recorded by a profiled Mutex)
+                 * @return whether or not the lock has been acquired
+                 */
+                CASIMIR_EXPORT bool tryAcquireLockFor(std::chrono::nanoseconds timeout,
+                                                      const char* file = CASIMIR_CALL_SITE_FILE,
+                                                      int line = CASIMIR_CALL_SITE_LINE);
 
                 /**
                  * @brief release the lock owned by the current thread
@@ -42,8 +155,12 @@ namespace Casimir {
 
                 /**
                  * @brief acquire the lock. This operation block the thread until the lock is acquired
+                 * @note Threads acquire the lock in the order they called this function
+                 * @param file the file of the call site (recorded by a profiled Mutex)
+                 * @param line the line of the call site (recorded by a profiled Mutex)
                  */
-                CASIMIR_EXPORT void acquireLock();
+                CASIMIR_EXPORT void acquireLock(const char* file = CASIMIR_CALL_SITE_FILE,
+                                                int line = CASIMIR_CALL_SITE_LINE);
 
                 /**
                  * @brief Determine if the current thread own the lock
@@ -52,6 +169,92 @@ namespace Casimir {
                 CASIMIR_EXPORT bool ownLock();
             };
 
+            /**
+             * @brief Reader-writer lock for state that is read far more often than it is written. Each reader only
+             * touches its own counter (one cache line per slot, slots shared by threads in round-robin) so that
+             * readers do not contend with each other. A waiting writer blocks the new readers so that it cannot
+             * starve, writers are served one at a time
+             */
+            class SharedMutex {
+                CASIMIR_DISABLE_COPY_MOVE(SharedMutex);
+            private:
+                struct alignas(64) ReaderSlot {
+                    std::atomic<cuint> count{0};
+                };
+
+                const cuint m_slotMask;
+                std::unique_ptr<ReaderSlot[]> m_slots;
+                alignas(64) std::atomic<bool> m_writer;
+                std::atomic<std::thread::id> m_writerId;
+                std::mutex m_writerMutex;
+
+                std::atomic<cuint> m_parked;
+                std::mutex m_parkMutex;
+                std::condition_variable m_parkCondition;
+
+                // Set while the writer sleeps until a reader slot drains
+                std::atomic<bool> m_writerParked;
+                std::condition_variable m_writerCondition;
+
+                /**
+                 * @brief Return the reader slot of the current thread
+                 * @return the reader slot
+                 */
+                ReaderSlot& slot();
+
+                /**
+                 * @brief Leave a reader slot and wake the parked writer if the slot drained
+                 * @param readerSlot the slot the thread entered
+                 */
+                void leave(ReaderSlot& readerSlot);
+
+                /**
+                 * @brief Block the writer until no reader is left in a slot
+                 * @param readerSlot the slot to drain
+                 */
+                void waitForReaders(ReaderSlot& readerSlot);
+
+                /**
+                 * @brief Block the thread until no writer holds or waits for the lock
+                 */
+                void waitForWriter();
+
+            public:
+                /**
+                 * @brief Default constructor. One reader slot is allocated per hardware thread (up to 64)
+                 */
+                CASIMIR_EXPORT SharedMutex();
+
+                /**
+                 * @brief acquire the lock in shared mode. This operation block the thread while a writer holds or
+                 * waits for the lock
+                 */
+                CASIMIR_EXPORT void acquireSharedLock();
+
+                /**
+                 * @brief acquire the lock in shared mode if no writer holds or waits for it
+                 * @return the success of the operation describe above
+                 */
+                CASIMIR_EXPORT bool tryAcquireSharedLock();
+
+                /**
+                 * @brief release the lock previously acquired in shared mode by the current thread
+                 */
+                CASIMIR_EXPORT void releaseSharedLock();
+
+                /**
+                 * @brief acquire the lock in exclusive mode. This operation block the thread until every reader
+                 * and the other writers released the lock
+                 */
+                CASIMIR_EXPORT void acquireLock();
+
+                /**
+                 * @brief release the lock acquired in exclusive mode by the current thread
+                 * @throw Exception if the current thread doesn't actually own the lock in exclusive mode
+                 */
+                CASIMIR_EXPORT void releaseLock();
+            };
+
         };
 
 }
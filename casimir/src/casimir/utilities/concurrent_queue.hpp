@@ -0,0 +1,342 @@
+#ifndef CASIMIR_CONCURRENT_QUEUE_HPP_
+#define CASIMIR_CONCURRENT_QUEUE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "../casimir.hpp"
+#include "exception.hpp"
+
+namespace Casimir {
+
+    namespace utilities {
+
+        /**
+         * @brief Bounded lock-free multi-producer multi-consumer queue. Each slot holds a sequence number telling
+         * whether it is ready to be written or read for a given lap (see D. Vyukov bounded queue), so producers only
+         * contend on the enqueue counter and consumers on the dequeue counter. The slots are padded to a cache line so
+         * that neighbouring producers and consumers don't share one
+         * @note The blocking functions spin shortly before sleeping, the non-blocking ones never take a lock
+         * @tparam T the type of the elements (must be move constructible)
+         */
+        template<typename T>
+        class ConcurrentQueue {
+            CASIMIR_DISABLE_COPY_MOVE(ConcurrentQueue);
+        private:
+            struct alignas(64) Slot {
+                std::atomic<cuint> sequence;
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+                inline T& value() {
+                    return *std::launder(reinterpret_cast<T*>(&storage));
+                }
+            };
+
+            /**
+             * @brief Number of failed attempts of a blocking operation before the thread goes to sleep
+             */
+            static constexpr cuint s_spinCount = 64;
+
+            const cuint m_mask;
+            std::unique_ptr<Slot[]> m_slots;
+
+            alignas(64) std::atomic<cuint> m_enqueuePosition;
+            alignas(64) std::atomic<cuint> m_dequeuePosition;
+
+            alignas(64) std::atomic<cuint> m_waitingProducers;
+            std::atomic<cuint> m_waitingConsumers;
+            std::mutex m_waitMutex;
+            std::condition_variable m_notFull;
+            std::condition_variable m_notEmpty;
+
+            static cuint roundCapacity(cuint capacity) {
+                if (capacity == 0) {
+                    CASIMIR_THROW_EXCEPTION("InvalidArgument", "The capacity of a ConcurrentQueue cannot be 0");
+                }
+                cuint result = 2;
+                while (result < capacity) result <<= 1U;
+                return result;
+            }
+
+            /**
+             * @brief Claim up to `count` consecutive slots, either free ones (`ready` = 0) or filled ones (`ready` =
+             * 1), starting at the position of `counter`
+             * @return the number of slots claimed, starting at `position`
+             */
+            cuint claim(std::atomic<cuint>& counter, cuint ready, cuint count, cuint& position) {
+                position = counter.load(std::memory_order_relaxed);
+                while (true) {
+                    // Only the slots that are ready for the current lap can be claimed
+                    cuint available = 0;
+                    cint difference = 0;
+                    while (available < count) {
+                        const Slot& slot = m_slots[(position + available) & m_mask];
+                        difference = (cint) slot.sequence.load(std::memory_order_acquire) -
+                                     (cint) (position + available + ready);
+                        if (difference != 0) break;
+                        ++available;
+                    }
+                    if (available == 0) {
+                        if (difference < 0) return 0; // The queue is full (or empty)
+                        position = counter.load(std::memory_order_relaxed); // Another thread moved the counter
+                        continue;
+                    }
+                    if (counter.compare_exchange_weak(position, position + available, std::memory_order_relaxed)) {
+                        return available;
+                    }
+                }
+            }
+
+            template<typename Function>
+            inline cuint writeSlots(cuint position, cuint count, Function&& construct) {
+                for (cuint i = 0; i < count; ++i) {
+                    Slot& slot = m_slots[(position + i) & m_mask];
+                    construct(&slot.storage, i);
+                    slot.sequence.store(position + i + 1, std::memory_order_release);
+                }
+                notify(m_waitingConsumers, m_notEmpty);
+                return count;
+            }
+
+            template<typename Function>
+            inline cuint readSlots(cuint position, cuint count, Function&& receive) {
+                for (cuint i = 0; i < count; ++i) {
+                    Slot& slot = m_slots[(position + i) & m_mask];
+                    receive(std::move(slot.value()), i);
+                    slot.value().~T();
+                    slot.sequence.store(position + i + m_mask + 1, std::memory_order_release);
+                }
+                notify(m_waitingProducers, m_notFull);
+                return count;
+            }
+
+            /**
+             * @brief Wake up the threads sleeping on `condition`, if any
+             */
+            inline void notify(std::atomic<cuint>& waiting, std::condition_variable& condition) {
+                // Either the sleeping threads are seen here or they see the new sequence before going to sleep
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (waiting.load(std::memory_order_relaxed) != 0) {
+                    std::lock_guard<std::mutex> lock(m_waitMutex);
+                    condition.notify_all();
+                }
+            }
+
+            /**
+             * @brief Whether or not the slot at the position of `counter` may be claimed (see claim)
+             */
+            inline bool isClaimable(const std::atomic<cuint>& counter, cuint ready) const {
+                const cuint position = counter.load(std::memory_order_relaxed);
+                const Slot& slot = m_slots[position & m_mask];
+                return (cint) slot.sequence.load(std::memory_order_acquire) - (cint) (position + ready) >= 0;
+            }
+
+            /**
+             * @brief Retry `attempt` until it succeeds or `deadline` expires (if any), sleeping on `condition` after a
+             * few failures
+             * @return whether or not `attempt` succeeded
+             */
+            template<typename Attempt>
+            bool wait(std::atomic<cuint>& waiting, std::condition_variable& condition,
+                      const std::atomic<cuint>& counter, cuint ready,
+                      std::optional<std::chrono::steady_clock::time_point> deadline, Attempt&& attempt) {
+                for (cuint i = 0; i < s_spinCount; ++i) {
+                    if (attempt()) return true;
+                    if (i >= s_spinCount / 2) std::this_thread::yield();
+                }
+
+                // The attempt itself notifies the other side, hence it cannot be made while holding the wait mutex
+                waiting.fetch_add(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                bool success;
+                const auto claimable = [&]() { return isClaimable(counter, ready); };
+                while (!(success = attempt())) {
+                    std::unique_lock<std::mutex> lock(m_waitMutex);
+                    if (!deadline) {
+                        condition.wait(lock, claimable);
+                    } else if (!condition.wait_until(lock, *deadline, claimable)) {
+                        lock.unlock();
+                        success = attempt();
+                        break;
+                    }
+                }
+                waiting.fetch_sub(1);
+                return success;
+            }
+
+        public:
+            /**
+             * @brief Create an empty queue
+             * @param capacity the minimum number of elements the queue can hold (rounded up to a power of two)
+             * @throw Casimir::Exception if the capacity is 0
+             */
+            explicit ConcurrentQueue(cuint capacity)
+                : m_mask(roundCapacity(capacity) - 1), m_slots(new Slot[m_mask + 1]), m_enqueuePosition(0),
+                  m_dequeuePosition(0), m_waitingProducers(0), m_waitingConsumers(0)
+            {
+                for (cuint i = 0; i <= m_mask; ++i) {
+                    m_slots[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            /**
+             * @brief Push an element constructed in place if the queue isn't full
+             * @param args the arguments used to construct the element
+             * @return whether or not the element has been pushed
+             */
+            template<typename... Args>
+            bool tryEmplace(Args&&... args) {
+                cuint position;
+                if (claim(m_enqueuePosition, 0, 1, position) == 0) return false;
+                writeSlots(position, 1, [&](void* storage, cuint) { new (storage) T(std::forward<Args>(args)...); });
+                return true;
+            }
+
+            /**
+             * @brief Push an element if the queue isn't full
+             * @param value the element to be pushed
+             * @return whether or not the element has been pushed
+             */
+            inline bool tryPush(T value) {
+                return tryEmplace(std::move(value));
+            }
+
+            /**
+             * @brief Push as many elements of `values` as the queue can take with a single update of the enqueue
+             * counter. The elements are moved in order
+             * @param values the elements to be pushed
+             * @param count the number of elements of `values`
+             * @return the number of elements pushed (the first ones of `values`)
+             */
+            cuint tryPushBatch(T* values, cuint count) {
+                cuint position;
+                const cuint claimed = claim(m_enqueuePosition, 0, count, position);
+                if (claimed == 0) return 0;
+                return writeSlots(position, claimed, [&](void* storage, cuint i) {
+                    new (storage) T(std::move(values[i]));
+                });
+            }
+
+            /**
+             * @brief Pop the oldest element if the queue isn't empty
+             * @param value where the element is moved to
+             * @return whether or not an element has been popped
+             */
+            bool tryPop(T& value) {
+                cuint position;
+                if (claim(m_dequeuePosition, 1, 1, position) == 0) return false;
+                readSlots(position, 1, [&](T&& element, cuint) { value = std::move(element); });
+                return true;
+            }
+
+            /**
+             * @brief Pop up to `maxCount` of the oldest elements with a single update of the dequeue counter
+             * @param values where the elements are moved to, in order
+             * @param maxCount the maximum number of elements popped
+             * @return the number of elements popped
+             */
+            cuint tryPopBatch(T* values, cuint maxCount) {
+                cuint position;
+                const cuint claimed = claim(m_dequeuePosition, 1, maxCount, position);
+                if (claimed == 0) return 0;
+                return readSlots(position, claimed, [&](T&& element, cuint i) { values[i] = std::move(element); });
+            }
+
+            /**
+             * @brief Push an element, waiting for a free slot if the queue is full
+             * @param value the element to be pushed
+             */
+            void push(T value) {
+                wait(m_waitingProducers, m_notFull, m_enqueuePosition, 0, std::nullopt,
+                     [&]() { return tryEmplace(std::move(value)); });
+            }
+
+            /**
+             * @brief Push an element, waiting at most `timeout` for a free slot if the queue is full
+             * @param value the element to be pushed
+             * @param timeout the maximum time spent waiting
+             * @return whether or not the element has been pushed
+             */
+            bool tryPushFor(T value, std::chrono::nanoseconds timeout) {
+                return wait(m_waitingProducers, m_notFull, m_enqueuePosition, 0,
+                            std::chrono::steady_clock::now() + timeout, [&]() { return tryEmplace(std::move(value)); });
+            }
+
+            /**
+             * @brief Pop the oldest element, waiting for one if the queue is empty
+             * @return the element popped
+             */
+            T pop() {
+                std::optional<T> value;
+                wait(m_waitingConsumers, m_notEmpty, m_dequeuePosition, 1, std::nullopt, [&]() {
+                    cuint position;
+                    if (claim(m_dequeuePosition, 1, 1, position) == 0) return false;
+                    readSlots(position, 1, [&](T&& element, cuint) { value.emplace(std::move(element)); });
+                    return true;
+                });
+                return std::move(*value);
+            }
+
+            /**
+             * @brief Pop the oldest element, waiting at most `timeout` for one if the queue is empty
+             * @param value where the element is moved to
+             * @param timeout the maximum time spent waiting
+             * @return whether or not an element has been popped
+             */
+            bool tryPopFor(T& value, std::chrono::nanoseconds timeout) {
+                return wait(m_waitingConsumers, m_notEmpty, m_dequeuePosition, 1,
+                            std::chrono::steady_clock::now() + timeout, [&]() { return tryPop(value); });
+            }
+
+            /**
+             * @brief Return the number of elements in the queue
+             * @note The result is only a snapshot when other threads use the queue
+             * @return the number of elements
+             */
+            cuint size() const {
+                const cuint dequeued = m_dequeuePosition.load(std::memory_order_acquire);
+                const cuint enqueued = m_enqueuePosition.load(std::memory_order_acquire);
+                return enqueued > dequeued ? enqueued - dequeued : 0;
+            }
+
+            /**
+             * @brief Whether or not the queue is empty (see size)
+             * @return the result of the above check
+             */
+            inline bool isEmpty() const {
+                return size() == 0;
+            }
+
+            /**
+             * @brief Return the maximum number of elements in the queue
+             * @return the capacity of the queue
+             */
+            inline cuint capacity() const {
+                return m_mask + 1;
+            }
+
+            /**
+             * @brief Destroy the elements left in the queue
+             */
+            ~ConcurrentQueue() {
+                cuint position = m_dequeuePosition.load(std::memory_order_relaxed);
+                while (m_slots[position & m_mask].sequence.load(std::memory_order_relaxed) == position + 1) {
+                    m_slots[position & m_mask].value().~T();
+                    ++position;
+                }
+            }
+        };
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,411 @@
+#ifndef CASIMIR_CONCURRENT_UUID_MAP_HPP_
+#define CASIMIR_CONCURRENT_UUID_MAP_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../casimir.hpp"
+#include "cmutex.hpp"
+#include "exception.hpp"
+#include "uuid.hpp"
+
+namespace Casimir {
+
+    namespace utilities {
+
+        /**
+         * @brief Concurrent hash map keyed by Uuid. The keys are spread over independent shards (cache-line aligned)
+         * so that threads working on different keys don't touch the same memory. Each shard is an open-addressing
+         * table of pointers to immutable nodes:
+         * - a lookup never waits: it announces itself with the current epoch on the reader slot of its thread (one
+         *   cache line per hardware thread, as SharedMutex), probes the table and leaves
+         * - the writers of a shard are serialized by its Mutex, they publish new nodes (or a bigger table) with a
+         *   single pointer store and retire the nodes they replaced. A retired node is freed once the epoch moved
+         *   three times, which requires every lookup announced before it was retired to be over
+         * @note A writer finding too many nodes retired in its shard waits for the running lookups to move on, so that
+         * the memory retired stays bounded even if lookups never stop
+         * @tparam V the type of the values (must be copy constructible)
+         */
+        template<typename V>
+        class ConcurrentUuidMap {
+            CASIMIR_DISABLE_COPY_MOVE(ConcurrentUuidMap);
+        private:
+            struct Node {
+                const Uuid key;
+                const uint64 hash;
+                const V value;
+            };
+
+            struct Table {
+                const cuint mask;
+                std::unique_ptr<std::atomic<Node*>[]> buckets;
+
+                explicit Table(cuint capacity) : mask(capacity - 1), buckets(new std::atomic<Node*>[capacity]) {
+                    for (cuint i = 0; i < capacity; ++i) buckets[i].store(nullptr, std::memory_order_relaxed);
+                }
+            };
+
+            /**
+             * @brief Node or table replaced by a writer, along with the epoch it has been retired in
+             */
+            struct Retired {
+                cuint epoch;
+                Node* node;
+                Table* table;
+            };
+
+            struct alignas(64) Shard {
+                std::atomic<Table*> table{nullptr};
+                std::atomic<cuint> size{0};
+
+                // Only accessed by the writer (holding the Mutex)
+                Mutex mutex;
+                cuint used = 0; // Live nodes and tombstones
+                std::vector<Retired> retired; // Ordered by epoch
+            };
+
+            struct alignas(64) ReaderSlot {
+                std::atomic<cuint> lookups[2] = {}; // Running lookups by parity of the epoch they announced
+            };
+
+            static constexpr cuint s_initialCapacity = 16;
+
+            /**
+             * @brief Number of nodes and tables retired in a shard above which a writer waits to free them
+             */
+            static constexpr cuint s_retiredLimit = 128;
+
+            const cuint m_shardMask;
+            std::unique_ptr<Shard[]> m_shards;
+            const cuint m_slotMask;
+            std::unique_ptr<ReaderSlot[]> m_slots;
+            alignas(64) std::atomic<cuint> m_epoch;
+
+            static cuint roundShardCount(cuint shardCount) {
+                if (shardCount == 0) {
+                    CASIMIR_THROW_EXCEPTION("InvalidArgument", "A ConcurrentUuidMap requires at least one shard");
+                }
+                cuint result = 1;
+                while (result < shardCount) result <<= 1U;
+                return result;
+            }
+
+            /**
+             * @brief Number of reader slots (power of two), one per hardware thread up to 64
+             */
+            static cuint slotCount() {
+                const cuint threads = std::max<cuint>(std::thread::hardware_concurrency(), 1);
+                cuint count = 1;
+                while (count < threads && count < 64) count <<= 1U;
+                return count;
+            }
+
+            /**
+             * @brief Return the reader slot of the current thread (the threads are given an index round-robin)
+             */
+            ReaderSlot& readerSlot() const {
+                static std::atomic<cuint> nextIndex(0);
+                static thread_local const cuint index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+                return m_slots[index & m_slotMask];
+            }
+
+            /**
+             * @brief Marks a bucket whose node has been erased (a lookup keeps probing past it)
+             */
+            static Node* tombstone() {
+                return reinterpret_cast<Node*>(static_cast<std::uintptr_t>(1));
+            }
+
+            /**
+             * @brief Mix both halves of the Uuid (the counter generator only changes the low bits)
+             */
+            static uint64 hashOf(const Uuid& key) {
+                uint64 hash = *key.mostSignificant() ^ (*key.lessSignificant() * 0x9E3779B97F4A7C15ULL);
+                hash ^= hash >> 30U;
+                hash *= 0xBF58476D1CE4E5B9ULL;
+                hash ^= hash >> 27U;
+                hash *= 0x94D049BB133111EBULL;
+                return hash ^ (hash >> 31U);
+            }
+
+            inline Shard& shardOf(uint64 hash) const {
+                return m_shards[(hash >> 48U) & m_shardMask];
+            }
+
+            /**
+             * @brief Return the node of `key` in `table`, nullptr if absent
+             */
+            static Node* findNode(const Table& table, const Uuid& key, uint64 hash) {
+                for (cuint i = hash & table.mask;; i = (i + 1) & table.mask) {
+                    Node* node = table.buckets[i].load(); // Ordered after the announcement of the lookup
+                    if (node == nullptr) return nullptr;
+                    if (node != tombstone() && node->hash == hash && node->key == key) return node;
+                }
+            }
+
+            /**
+             * @brief Return the bucket of `key` in `table` (writer only). If the key is absent, the first reusable
+             * bucket of its probe sequence
+             */
+            static std::atomic<Node*>& findBucket(Table& table, const Uuid& key, uint64 hash) {
+                std::atomic<Node*>* reusable = nullptr;
+                for (cuint i = hash & table.mask;; i = (i + 1) & table.mask) {
+                    std::atomic<Node*>& bucket = table.buckets[i];
+                    Node* node = bucket.load(std::memory_order_relaxed);
+                    if (node == nullptr) return reusable != nullptr ? *reusable : bucket;
+                    if (node == tombstone()) {
+                        if (reusable == nullptr) reusable = &bucket;
+                    } else if (node->hash == hash && node->key == key) {
+                        return bucket;
+                    }
+                }
+            }
+
+            /**
+             * @brief Replace the table of the shard by one sized for its live nodes (writer only)
+             */
+            void grow(Shard& shard) {
+                Table* table = shard.table.load(std::memory_order_relaxed);
+                cuint capacity = s_initialCapacity;
+                while (capacity < shard.size.load(std::memory_order_relaxed) * 4) capacity <<= 1U;
+
+                Table* grown = new Table(capacity);
+                if (table != nullptr) {
+                    for (cuint i = 0; i <= table->mask; ++i) {
+                        Node* node = table->buckets[i].load(std::memory_order_relaxed);
+                        if (node == nullptr || node == tombstone()) continue;
+                        cuint j = node->hash & grown->mask;
+                        while (grown->buckets[j].load(std::memory_order_relaxed) != nullptr) j = (j + 1) & grown->mask;
+                        grown->buckets[j].store(node, std::memory_order_relaxed);
+                    }
+                }
+                shard.used = shard.size.load(std::memory_order_relaxed);
+                shard.table.store(grown);
+
+                // The epoch of the retirement is read once the old table cannot be reached anymore (see reclaim)
+                if (table != nullptr) shard.retired.push_back({m_epoch.load(), nullptr, table});
+            }
+
+            /**
+             * @brief Move to the next epoch if no lookup announced the previous one is running anymore
+             * @return whether or not the epoch moved (possibly by another writer)
+             */
+            bool advanceEpoch() {
+                cuint epoch = m_epoch.load();
+                for (cuint i = 0; i <= m_slotMask; ++i) {
+                    if (m_slots[i].lookups[(epoch + 1) & 1U].load() != 0) return false;
+                }
+                m_epoch.compare_exchange_strong(epoch, epoch + 1);
+                return true;
+            }
+
+            /**
+             * @brief Free what has been retired at least three epochs ago (writer only, something is retired). Each
+             * parity of the epoch has then been found without lookup after the retirement, and a lookup that started
+             * after it cannot reach what has been retired
+             */
+            void reclaim(Shard& shard) {
+                // The epoch moves as far as the oldest retirement requires (at once if no lookup is running)
+                while (m_epoch.load() - shard.retired.front().epoch < 3 && advanceEpoch()) {}
+                const cuint epoch = m_epoch.load();
+                auto end = shard.retired.begin();
+                for (; end != shard.retired.end() && epoch - end->epoch >= 3; ++end) {
+                    delete end->node;
+                    delete end->table;
+                }
+                shard.retired.erase(shard.retired.begin(), end);
+            }
+
+            /**
+             * @brief Retire `node` and free what can be (writer only). Past s_retiredLimit, wait for the lookups that
+             * hold the shard back
+             */
+            void retire(Shard& shard, Node* node) {
+                if (node != nullptr) shard.retired.push_back({m_epoch.load(), node, nullptr});
+                if (shard.retired.empty()) return;
+                reclaim(shard);
+                while (shard.retired.size() > s_retiredLimit) {
+                    std::this_thread::yield();
+                    reclaim(shard);
+                }
+            }
+
+            /**
+             * @brief Store `node` in the shard, replacing the node of the same key if `replace` is true
+             * @return whether or not the node has been stored (the map takes ownership of it)
+             */
+            bool store(Node* node, bool replace) {
+                Shard& shard = shardOf(node->hash);
+                shard.mutex.acquireLock();
+
+                // Keep at most half of the buckets used so that the probe sequences stay short
+                if (shard.table.load(std::memory_order_relaxed) == nullptr ||
+                    (shard.used + 1) * 2 > shard.table.load(std::memory_order_relaxed)->mask + 1) {
+                    grow(shard);
+                }
+                Table& table = *shard.table.load(std::memory_order_relaxed);
+                std::atomic<Node*>& bucket = findBucket(table, node->key, node->hash);
+                Node* previous = bucket.load(std::memory_order_relaxed);
+                const bool present = previous != nullptr && previous != tombstone();
+                if (present && !replace) {
+                    shard.mutex.releaseLock();
+                    return false;
+                }
+
+                bucket.store(node);
+                if (!present) {
+                    if (previous == nullptr) ++shard.used;
+                    shard.size.fetch_add(1, std::memory_order_relaxed);
+                }
+                retire(shard, present ? previous : nullptr);
+                shard.mutex.releaseLock();
+                return true;
+            }
+
+        public:
+            /**
+             * @brief Create an empty map
+             * @param shardCount the number of shards (rounded up to a power of two), a few times the number of
+             * threads using the map
+             * @throw Casimir::Exception if the shard count is 0
+             */
+            explicit ConcurrentUuidMap(cuint shardCount = 64)
+                : m_shardMask(roundShardCount(shardCount) - 1), m_shards(new Shard[m_shardMask + 1]),
+                  m_slotMask(slotCount() - 1), m_slots(new ReaderSlot[m_slotMask + 1]), m_epoch(0)
+            {
+
+            }
+
+            /**
+             * @brief Insert `value` if `key` isn't in the map yet
+             * @param key the key of the value
+             * @param value the value to be inserted
+             * @return whether or not the value has been inserted
+             */
+            bool insert(const Uuid& key, V value) {
+                Node* node = new Node{key, hashOf(key), std::move(value)};
+                if (store(node, false)) return true;
+                delete node;
+                return false;
+            }
+
+            /**
+             * @brief Insert `value`, replacing the value of `key` if it is already in the map
+             * @param key the key of the value
+             * @param value the value to be inserted
+             */
+            void insertOrAssign(const Uuid& key, V value) {
+                store(new Node{key, hashOf(key), std::move(value)}, true);
+            }
+
+            /**
+             * @brief Remove `key` from the map
+             * @param key the key to be removed
+             * @return whether or not the key was in the map
+             */
+            bool erase(const Uuid& key) {
+                const uint64 hash = hashOf(key);
+                Shard& shard = shardOf(hash);
+                shard.mutex.acquireLock();
+                Table* table = shard.table.load(std::memory_order_relaxed);
+                Node* node = table != nullptr ? findNode(*table, key, hash) : nullptr;
+                if (node != nullptr) {
+                    findBucket(*table, key, hash).store(tombstone());
+                    shard.size.fetch_sub(1, std::memory_order_relaxed);
+                    retire(shard, node);
+                }
+                shard.mutex.releaseLock();
+                return node != nullptr;
+            }
+
+            /**
+             * @brief Call `function` with the value of `key` without copying it. The value stays valid during the call
+             * even if another thread replaces or erases it
+             * @warning `function` must not modify the map (the thread could wait for its own lookup)
+             * @param key the key to look up
+             * @param function the function called with a const reference to the value
+             * @return whether or not the key was in the map (and `function` called)
+             */
+            template<typename Function>
+            bool visit(const Uuid& key, Function&& function) const {
+                const uint64 hash = hashOf(key);
+                const Shard& shard = shardOf(hash);
+                std::atomic<cuint>& lookups = readerSlot().lookups[m_epoch.load() & 1U];
+                lookups.fetch_add(1);
+                const Table* table = shard.table.load();
+                const Node* node = table != nullptr ? findNode(*table, key, hash) : nullptr;
+                if (node != nullptr) {
+                    try {
+                        function(node->value);
+                    } catch (...) {
+                        lookups.fetch_sub(1, std::memory_order_release);
+                        throw;
+                    }
+                }
+                lookups.fetch_sub(1, std::memory_order_release);
+                return node != nullptr;
+            }
+
+            /**
+             * @brief Copy the value of `key` into `value`
+             * @param key the key to look up
+             * @param value where the value is copied to
+             * @return whether or not the key was in the map
+             */
+            inline bool find(const Uuid& key, V& value) const {
+                return visit(key, [&value](const V& found) { value = found; });
+            }
+
+            /**
+             * @brief Whether or not `key` is in the map
+             * @param key the key to look up
+             * @return the result of the above check
+             */
+            inline bool contains(const Uuid& key) const {
+                return visit(key, [](const V&) {});
+            }
+
+            /**
+             * @brief Return the number of keys in the map
+             * @note The result is only a snapshot when other threads use the map
+             * @return the number of keys
+             */
+            cuint size() const {
+                cuint size = 0;
+                for (cuint i = 0; i <= m_shardMask; ++i) size += m_shards[i].size.load(std::memory_order_relaxed);
+                return size;
+            }
+
+            /**
+             * @brief Destroy the values of the map
+             * @warning No other thread may use the map anymore
+             */
+            ~ConcurrentUuidMap() {
+                for (cuint i = 0; i <= m_shardMask; ++i) {
+                    Shard& shard = m_shards[i];
+                    Table* table = shard.table.load(std::memory_order_relaxed);
+                    if (table != nullptr) {
+                        for (cuint j = 0; j <= table->mask; ++j) {
+                            Node* node = table->buckets[j].load(std::memory_order_relaxed);
+                            if (node != nullptr && node != tombstone()) delete node;
+                        }
+                        delete table;
+                    }
+                    for (const Retired& retired : shard.retired) {
+                        delete retired.node;
+                        delete retired.table;
+                    }
+                }
+            }
+        };
+
+    }
+
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "exception.hpp"
+#include "string_builder.hpp"
 
 namespace Casimir {
 
@@ -11,7 +12,7 @@ using namespace literals;
 
     CASIMIR_EXPORT utilities::Exception::Exception(const String &error, const String &cause, const String &file,
                                                const cuint &line)
-        : m_str("[" + file + " @ " + String::toString((cint)line) + "]:\n\t Error {" + error + "} : " + cause)
+        : m_str(StringBuilder::concat("[", file, " @ ", String::toString((cint) line), "]:\n\t Error {", error, "} : ", cause))
     {}
     
 }
@@ -55,7 +55,7 @@ namespace Casimir {
              * @return A formatted C string
              */
             const char * what() const noexcept override {
-                return toString().c_str();
+                return m_str.c_str();
             }
         };
 
@@ -0,0 +1,449 @@
+#include "log_index.hpp"
+#include "exception.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace Casimir {
+
+    using namespace literals;
+
+    static const char s_indexMagic[8] = {'C', 'S', 'M', 'R', 'L', 'I', 'D', 'X'};
+    static const std::uint32_t s_indexVersion = 1;
+    static const cuint s_indexHeaderSize = 24;
+
+    static_assert(sizeof(utilities::LogIndexEntry) == 32 && s_indexHeaderSize % alignof(utilities::LogIndexEntry) == 0,
+                  "LogIndexEntry is read in place from the mapped sidecar index");
+
+    /**
+     * @brief Throw a SystemException describing the last error of the platform
+     */
+    [[noreturn]] static void throwSystemError(const utilities::String& what) {
+#ifdef _WIN32
+        const int error = (int) GetLastError();
+#else
+        const int error = errno;
+#endif
+        using utilities::Exception;
+        CASIMIR_THROW_EXCEPTION("SystemException", std::system_error(error, std::system_category(), what.str()).what());
+    }
+
+    /**
+     * @brief Parse exactly `count` decimal digits
+     * @return false if one of the characters isn't a digit
+     */
+    static bool parseDigits(const char* data, cuint count, int64& value) {
+        value = 0;
+        for (cuint i = 0; i < count; ++i) {
+            if (data[i] < '0' || data[i] > '9') return false;
+            value = value * 10 + (data[i] - '0');
+        }
+        return true;
+    }
+
+    /**
+     * @brief Number of days between 1970-01-01 and the given date of the proleptic Gregorian calendar
+     * (see H. Hinnant, chrono-compatible low-level date algorithms)
+     */
+    static int64 daysFromCivil(int64 year, int64 month, int64 day) {
+        year -= month <= 2;
+        const int64 era = (year >= 0 ? year : year - 399) / 400;
+        const int64 yearOfEra = year - era * 400;
+        const int64 dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const int64 dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    /**
+     * @brief Parse the header line `[ <time> ] <padding><channel> : ` of the formattedParser layout
+     * @param line the first character of the line
+     * @param length the length of the line (without the line feed)
+     * @param timestamp the timestamp of the record
+     * @param channel the first character of the channel name
+     * @param channelLength the length of the channel name
+     * @return false if the line isn't a header line
+     */
+    static bool parseHeader(const char* line, cuint length, int64& timestamp, const char*& channel, cuint& channelLength) {
+        if (length < 2 || line[0] != '[' || line[1] != ' ') return false;
+        const cuint consumed = utilities::LogIndex::parseTimestamp(line + 2, length - 2, timestamp);
+        if (consumed == 0) return false;
+
+        // The time ends with its own " [ UTC+0000 ]" followed by the " ] " of the header
+        const char* cursor = line + 2 + consumed;
+        const char* end = line + length;
+        while (cursor + 4 <= end && memcmp(cursor, "] ] ", 4) != 0) ++cursor;
+        if (cursor + 4 > end) return false;
+        cursor += 4;
+        while (cursor < end && *cursor == ' ') ++cursor;
+
+        channel = cursor;
+        while (cursor + 3 <= end && memcmp(cursor, " : ", 3) != 0) ++cursor;
+        if (cursor + 3 > end || cursor == channel) return false;
+        channelLength = (cuint) (cursor - channel);
+        return true;
+    }
+
+    /**
+     * @brief Whether or not the line is a `| ` continuation line of the formattedParser layout
+     */
+    static bool isContinuation(const char* line, cuint length) {
+        cuint position = 0;
+        while (position < length && line[position] == ' ') ++position;
+        return position != 0 && position + 1 < length && line[position] == '|' && line[position + 1] == ' ';
+    }
+
+    CASIMIR_EXPORT cuint utilities::LogIndex::parseTimestamp(const char* data, cuint length, int64& timestamp) {
+        // YYYY-MM-DD
+        int64 year, month, day, hour, minute, second;
+        if (length < 10 || !parseDigits(data, 4, year) || data[4] != '-' || !parseDigits(data + 5, 2, month) ||
+            data[7] != '-' || !parseDigits(data + 8, 2, day)) {
+            return 0;
+        }
+        cuint position = 10;
+
+        // Date and time separator
+        if (length >= position + 4 && memcmp(data + position, " at ", 4) == 0) {
+            position += 4;
+        } else if (length > position && (data[position] == ' ' || data[position] == 'T')) {
+            position += 1;
+        } else {
+            return 0;
+        }
+
+        // HH:MM:SS
+        if (length < position + 8 || !parseDigits(data + position, 2, hour) || data[position + 2] != ':' ||
+            !parseDigits(data + position + 3, 2, minute) || data[position + 5] != ':' ||
+            !parseDigits(data + position + 6, 2, second)) {
+            return 0;
+        }
+        position += 8;
+        if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) return 0;
+
+        // Optional sub-second suffix (up to the microsecond)
+        int64 microsecond = 0;
+        if (position < length && data[position] == '.') {
+            ++position;
+            cuint digits = 0;
+            while (position < length && data[position] >= '0' && data[position] <= '9') {
+                if (digits < 6) {
+                    microsecond = microsecond * 10 + (data[position] - '0');
+                    ++digits;
+                }
+                ++position;
+            }
+            for (; digits < 6; ++digits) microsecond *= 10;
+        }
+
+        timestamp = ((daysFromCivil(year, month, day) * 24 + hour) * 60 + minute) * 60 + second;
+        timestamp = timestamp * 1000000 + microsecond;
+        return position;
+    }
+
+    CASIMIR_EXPORT utilities::LogIndex::LogIndex(const utilities::String& logPath, const utilities::String& indexPath)
+        : m_logPath(logPath), m_indexPath(indexPath.isEmpty() ? logPath + ".idx" : indexPath),
+          m_channelsPath(m_indexPath + ".channels"), m_persistedEntries(0), m_persistedChannels(0), m_indexedSize(0) {
+        try {
+            map(m_log, m_logPath);
+            load();
+            update();
+        } catch (...) {
+            unmap(m_log);
+            unmap(m_index);
+            throw;
+        }
+    }
+
+    void utilities::LogIndex::unmap(utilities::LogIndex::MappedFile& file) {
+#ifdef _WIN32
+        if (file.data) UnmapViewOfFile(file.data);
+        if (file.mapping) CloseHandle(file.mapping);
+        if (file.file) CloseHandle(file.file);
+        file.file = nullptr;
+        file.mapping = nullptr;
+#else
+        if (file.data) munmap((void*) file.data, (size_t) file.size);
+        if (file.fd >= 0) close(file.fd);
+        file.fd = -1;
+#endif
+        file.data = nullptr;
+        file.size = 0;
+    }
+
+    void utilities::LogIndex::map(utilities::LogIndex::MappedFile& file, const utilities::String& path) {
+        unmap(file);
+#ifdef _WIN32
+        file.file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file.file == INVALID_HANDLE_VALUE) {
+            file.file = nullptr;
+            throwSystemError("Cannot open file " + path);
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file.file, &size)) throwSystemError("Cannot read the size of file " + path);
+        file.size = (uint64) size.QuadPart;
+        if (file.size == 0) return;
+        file.mapping = CreateFileMappingA(file.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!file.mapping) throwSystemError("Cannot map file " + path);
+        file.data = (const char*) MapViewOfFile(file.mapping, FILE_MAP_READ, 0, 0, (SIZE_T) file.size);
+        if (!file.data) throwSystemError("Cannot map file " + path);
+#else
+        file.fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file.fd < 0) throwSystemError("Cannot open file " + path);
+        struct stat status{};
+        if (fstat(file.fd, &status) != 0) throwSystemError("Cannot read the size of file " + path);
+        file.size = (uint64) status.st_size;
+        if (file.size == 0) return;
+        void* data = mmap(nullptr, (size_t) file.size, PROT_READ, MAP_SHARED, file.fd, 0);
+        if (data == MAP_FAILED) {
+            file.size = 0;
+            throwSystemError("Cannot map file " + path);
+        }
+        file.data = (const char*) data;
+#endif
+    }
+
+    std::uint32_t utilities::LogIndex::channelId(const char* name, cuint length) {
+        std::string key(name, (size_t) length);
+        auto it = m_channelIds.find(key);
+        if (it != m_channelIds.end()) return it->second;
+        const auto id = (std::uint32_t) m_channelNames.size();
+        m_channelNames.emplace_back(name, length);
+        m_channelIds.emplace(std::move(key), id);
+        return id;
+    }
+
+    const utilities::LogIndexEntry& utilities::LogIndex::entry(cuint position) const {
+        if (position < m_persistedEntries) {
+            return ((const LogIndexEntry*) (m_index.data + s_indexHeaderSize))[position];
+        }
+        return m_pending[position - m_persistedEntries];
+    }
+
+    void utilities::LogIndex::extendBlock(cuint position) {
+        const int64 timestamp = entry(position).timestamp;
+        if (position % s_blockSize == 0) {
+            m_blockRanges.emplace_back(timestamp, timestamp);
+        } else {
+            auto& range = m_blockRanges.back();
+            range.first = std::min(range.first, timestamp);
+            range.second = std::max(range.second, timestamp);
+        }
+    }
+
+    void utilities::LogIndex::popEntry() {
+        m_pending.pop_back();
+        const cuint count = size();
+        if (count % s_blockSize == 0) {
+            m_blockRanges.pop_back();
+            return;
+        }
+
+        // The removed entry may have widened the range of its block
+        const cuint blockStart = count - count % s_blockSize;
+        m_blockRanges.pop_back();
+        for (cuint i = blockStart; i < count; ++i) extendBlock(i);
+    }
+
+    void utilities::LogIndex::load() {
+        m_channelNames.clear();
+        m_channelIds.clear();
+        m_pending.clear();
+        m_blockRanges.clear();
+        unmap(m_index);
+
+        // Header of the index: magic, version and the position in the log file where the next update must start
+        bool valid = false;
+        {
+            std::ifstream stream(m_indexPath.c_str(), std::ios_base::in | std::ios_base::binary);
+            char header[s_indexHeaderSize];
+            std::uint32_t version;
+            if (stream.is_open() && stream.read(header, sizeof(header)) &&
+                memcmp(header, s_indexMagic, sizeof(s_indexMagic)) == 0) {
+                memcpy(&version, header + sizeof(s_indexMagic), sizeof(version));
+                memcpy(&m_indexedSize, header + sizeof(s_indexMagic) + 2 * sizeof(std::uint32_t),
+                       sizeof(m_indexedSize));
+                valid = version == s_indexVersion && m_indexedSize <= m_log.size;
+            }
+        }
+        if (valid) {
+            std::ifstream stream(m_channelsPath.c_str(), std::ios_base::in | std::ios_base::binary);
+            std::string name;
+            while (std::getline(stream, name)) channelId(name.data(), (cuint) name.size());
+            map(m_index, m_indexPath);
+            valid = (m_index.size - s_indexHeaderSize) % sizeof(LogIndexEntry) == 0;
+        }
+        if (valid) {
+            m_persistedEntries = (m_index.size - s_indexHeaderSize) / sizeof(LogIndexEntry);
+            for (cuint i = 0; valid && i < m_persistedEntries; ++i) {
+                valid = entry(i).channel < m_channelNames.size();
+                extendBlock(i);
+            }
+        }
+
+        // The log file must still contain the records of the index (neither truncated nor replaced)
+        if (valid && m_persistedEntries != 0) {
+            const LogIndexEntry& last = entry(m_persistedEntries - 1);
+            int64 timestamp;
+            const char* channel;
+            cuint channelLength;
+            valid = last.offset + last.length <= m_indexedSize &&
+                    parseHeader(m_log.data + last.offset, (cuint) last.length, timestamp, channel, channelLength) &&
+                    timestamp == last.timestamp && m_channelNames[last.channel] == String(channel, channelLength);
+        }
+
+        if (valid) {
+            m_persistedChannels = m_channelNames.size();
+            return;
+        }
+
+        // Start over with an empty index
+        m_channelNames.clear();
+        m_channelIds.clear();
+        m_blockRanges.clear();
+        m_persistedEntries = 0;
+        m_persistedChannels = 0;
+        m_indexedSize = 0;
+        unmap(m_index);
+
+        char header[s_indexHeaderSize] = {};
+        memcpy(header, s_indexMagic, sizeof(s_indexMagic));
+        memcpy(header + sizeof(s_indexMagic), &s_indexVersion, sizeof(s_indexVersion));
+        std::ofstream output(m_indexPath.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        output.write(header, sizeof(header));
+        std::ofstream channels(m_channelsPath.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!output || !channels) throwSystemError("Cannot write index file " + m_indexPath);
+    }
+
+    void utilities::LogIndex::persist(cuint completeCount, uint64 indexedSize) {
+        // The entries and channel names are appended before the indexed size so that an interrupted update is
+        // detected the next time the index is loaded
+        {
+            const cuint entryCount = completeCount - m_persistedEntries;
+            std::ofstream output(m_indexPath.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::app);
+            output.write((const char*) m_pending.data(), (std::streamsize) (entryCount * sizeof(LogIndexEntry)));
+            std::ofstream channels(m_channelsPath.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::app);
+            for (cuint i = m_persistedChannels; i < m_channelNames.size(); ++i) {
+                channels.write(m_channelNames[i].c_str(), (std::streamsize) m_channelNames[i].length());
+                channels.put('\n');
+            }
+            if (!output.flush() || !channels.flush()) throwSystemError("Cannot write index file " + m_indexPath);
+            m_pending.erase(m_pending.begin(), m_pending.begin() + (std::ptrdiff_t) entryCount);
+        }
+        {
+            std::fstream output(m_indexPath.c_str(), std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+            output.seekp((std::streamoff) (sizeof(s_indexMagic) + 2 * sizeof(std::uint32_t)));
+            output.write((const char*) &indexedSize, sizeof(indexedSize));
+            if (!output.flush()) throwSystemError("Cannot write index file " + m_indexPath);
+        }
+
+        m_persistedEntries = completeCount;
+        m_persistedChannels = m_channelNames.size();
+        m_indexedSize = indexedSize;
+        map(m_index, m_indexPath);
+    }
+
+    CASIMIR_EXPORT cuint utilities::LogIndex::update() {
+        map(m_log, m_logPath);
+        if (m_log.size < m_indexedSize) { // The log file has been truncated, start over
+            load();
+        }
+
+        // The last record is parsed again as continuation lines may have been appended to it
+        const cuint previousCount = size();
+        while (!m_pending.empty()) popEntry();
+
+        // Only the complete lines are parsed
+        const char* cursor = m_log.data ? m_log.data + m_indexedSize : nullptr;
+        const char* end = m_log.data ? m_log.data + m_log.size : nullptr;
+        bool lastIsRecord = false;
+        uint64 parsedSize = m_indexedSize;
+        while (cursor < end) {
+            const char* lineEnd = (const char*) memchr(cursor, '\n', (size_t) (end - cursor));
+            if (!lineEnd) break;
+            const auto lineLength = (cuint) (lineEnd - cursor);
+            const auto offset = (uint64) (cursor - m_log.data);
+
+            int64 timestamp;
+            const char* channel;
+            cuint channelLength;
+            if (parseHeader(cursor, lineLength, timestamp, channel, channelLength)) {
+                m_pending.push_back(LogIndexEntry{timestamp, offset, lineLength + 1, channelId(channel, channelLength), 0});
+                extendBlock(size() - 1);
+                lastIsRecord = true;
+            } else if (lastIsRecord && isContinuation(cursor, lineLength)) {
+                m_pending.back().length += lineLength + 1;
+            } else { // Line of the raw channel
+                lastIsRecord = false;
+            }
+            cursor = lineEnd + 1;
+            parsedSize = (uint64) (cursor - m_log.data);
+        }
+
+        // Every record but the one at the very end of the file is complete
+        const cuint completeCount = lastIsRecord ? size() - 1 : size();
+        const uint64 indexedSize = lastIsRecord ? m_pending.back().offset : parsedSize;
+        if (completeCount != m_persistedEntries || m_channelNames.size() != m_persistedChannels ||
+            indexedSize != m_indexedSize) {
+            persist(completeCount, indexedSize);
+        }
+        return size() - previousCount;
+    }
+
+    CASIMIR_EXPORT std::vector<utilities::LogIndexEntry> utilities::LogIndex::query(const utilities::String& channel,
+                                                                                  int64 from, int64 to) const {
+        std::vector<LogIndexEntry> result;
+        std::uint32_t id = 0;
+        if (!channel.isEmpty()) {
+            auto it = m_channelIds.find(channel.str());
+            if (it == m_channelIds.end()) return result;
+            id = it->second;
+        }
+
+        // Timestamps are only roughly increasing (several threads may log at once) hence the range of each block
+        const cuint count = size();
+        for (cuint block = 0; block < m_blockRanges.size(); ++block) {
+            if (m_blockRanges[block].second < from || m_blockRanges[block].first > to) continue;
+            const cuint blockEnd = std::min<cuint>(count, (block + 1) * s_blockSize);
+            for (cuint i = block * s_blockSize; i < blockEnd; ++i) {
+                const LogIndexEntry& current = entry(i);
+                if (current.timestamp < from || current.timestamp > to) continue;
+                if (!channel.isEmpty() && current.channel != id) continue;
+                result.push_back(current);
+            }
+        }
+        return result;
+    }
+
+    CASIMIR_EXPORT utilities::String utilities::LogIndex::text(const utilities::LogIndexEntry& entry) const {
+        return String(m_log.data + entry.offset, (cuint) entry.length);
+    }
+
+    CASIMIR_EXPORT const utilities::String& utilities::LogIndex::channelName(const utilities::LogIndexEntry& entry) const {
+        return m_channelNames[entry.channel];
+    }
+
+    CASIMIR_EXPORT cuint utilities::LogIndex::size() const {
+        return m_persistedEntries + m_pending.size();
+    }
+
+    CASIMIR_EXPORT utilities::LogIndex::~LogIndex() {
+        unmap(m_log);
+        unmap(m_index);
+    }
+
+}
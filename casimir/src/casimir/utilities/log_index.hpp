@@ -0,0 +1,194 @@
+#ifndef CASIMIR_LOG_INDEX_HPP_
+#define CASIMIR_LOG_INDEX_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../casimir.hpp"
+#include "string.hpp"
+
+namespace Casimir {
+
+    namespace utilities {
+
+        /**
+         * @brief A record of a text log file written with the formattedParser layout (header line followed by its
+         * `| ` continuation lines)
+         */
+        struct LogIndexEntry {
+            int64 timestamp;
+            uint64 offset;
+            uint64 length;
+            std::uint32_t channel;
+            std::uint32_t reserved;
+        };
+
+        /**
+         * @brief Sidecar index of a text log file (such as the one written by the FileLogger) by timestamp and
+         * channel name. The log file is memory-mapped and only the bytes appended since the last update are parsed.
+         * The entries are stored in `<indexPath>` (memory-mapped as well so that opening the index again doesn't read
+         * it) and the channel names in `<indexPath>.channels`
+         * @note The timestamps are expressed in microseconds since epoch (UTC)
+         */
+        class LogIndex {
+            CASIMIR_DISABLE_COPY_MOVE(LogIndex);
+        private:
+            /**
+             * @brief A read-only mapping of a whole file
+             */
+            struct MappedFile {
+                const char* data = nullptr;
+                uint64 size = 0;
+#ifdef _WIN32
+                void* file = nullptr;
+                void* mapping = nullptr;
+#else
+                int fd = -1;
+#endif
+            };
+
+            static constexpr cuint s_blockSize = 256;
+
+            const String m_logPath;
+            const String m_indexPath;
+            const String m_channelsPath;
+
+            MappedFile m_log;
+            MappedFile m_index;
+
+            std::vector<String> m_channelNames;
+            std::unordered_map<std::string, std::uint32_t> m_channelIds;
+            std::vector<LogIndexEntry> m_pending;
+            std::vector<std::pair<int64, int64>> m_blockRanges;
+            cuint m_persistedEntries;
+            cuint m_persistedChannels;
+            uint64 m_indexedSize;
+
+            /**
+             * @brief Map the whole file `path` (again) so that the bytes appended since the last mapping are visible
+             * @param file the mapping to be replaced
+             * @param path the path to the file
+             * @throw Casimir::Exception if the file cannot be opened or mapped
+             */
+            static void map(MappedFile& file, const String& path);
+
+            /**
+             * @brief Release a mapping
+             * @param file the mapping to be released
+             */
+            static void unmap(MappedFile& file);
+
+            /**
+             * @brief Read the sidecar index files, or create them if they are missing or don't match the log file
+             * @throw Casimir::Exception if the sidecar index files cannot be written
+             */
+            void load();
+
+            /**
+             * @brief Append the channels and the complete entries that are not in the sidecar index files yet
+             * @param completeCount the number of entries that will not change anymore
+             * @param indexedSize the position in the log file where the next update must start parsing
+             * @throw Casimir::Exception if the sidecar index files cannot be written
+             */
+            void persist(cuint completeCount, uint64 indexedSize);
+
+            /**
+             * @brief Return the identifier of the channel `name` (registered if needed)
+             * @param name the channel name
+             * @param length the length of the channel name
+             * @return the identifier of the channel
+             */
+            std::uint32_t channelId(const char* name, cuint length);
+
+            /**
+             * @brief Return an entry of the index (either from the sidecar index file or not persisted yet)
+             * @param position the position of the entry
+             * @return the entry
+             */
+            const LogIndexEntry& entry(cuint position) const;
+
+            /**
+             * @brief Add the entry at `position` to the time range of its block
+             * @param position the position of the entry
+             */
+            void extendBlock(cuint position);
+
+            /**
+             * @brief Remove the last entry of the index (which must not be persisted)
+             */
+            void popEntry();
+
+        public:
+            /**
+             * @brief Open (or build) the index of the log file `logPath` and bring it up to date
+             * @param logPath the path to the text log file
+             * @param indexPath the path to the sidecar index file (`<logPath>.idx` if empty)
+             * @throw Casimir::Exception if the log file cannot be mapped or the index file cannot be written
+             */
+            CASIMIR_EXPORT explicit LogIndex(const String& logPath, const String& indexPath = String());
+
+            /**
+             * @brief Index the records appended to the log file since the last update
+             * @note The last record of the file is only written to the sidecar index once another line follows it,
+             * as more continuation lines may still be appended to it
+             * @throw Casimir::Exception if the log file cannot be mapped or the index file cannot be written
+             * @return the number of records added to the index
+             */
+            CASIMIR_EXPORT cuint update();
+
+            /**
+             * @brief Return the records of the channel `channel` whose timestamp is in [from, to], in file order
+             * @param channel the channel name (such as ERROR), any channel if empty
+             * @param from the lowest timestamp (in microseconds since epoch)
+             * @param to the highest timestamp (in microseconds since epoch)
+             * @return the matching records
+             */
+            CASIMIR_EXPORT std::vector<LogIndexEntry> query(const String& channel,
+                                                            int64 from = std::numeric_limits<int64>::min(),
+                                                            int64 to = std::numeric_limits<int64>::max()) const;
+
+            /**
+             * @brief Return the text of a record (header and continuation lines)
+             * @param entry a record of this index
+             * @return the text of the record
+             */
+            CASIMIR_EXPORT String text(const LogIndexEntry& entry) const;
+
+            /**
+             * @brief Return the channel name of a record
+             * @param entry a record of this index
+             * @return the channel name
+             */
+            CASIMIR_EXPORT const String& channelName(const LogIndexEntry& entry) const;
+
+            /**
+             * @brief Return the number of records in the index
+             * @return the number of records
+             */
+            CASIMIR_EXPORT cuint size() const;
+
+            /**
+             * @brief Parse a timestamp of format `YYYY-MM-DD at HH:MM:SS` (`YYYY-MM-DD HH:MM:SS` and
+             * `YYYY-MM-DDTHH:MM:SS` are also accepted) optionally followed by a sub-second suffix
+             * @param data the text to be parsed
+             * @param length the length of the text
+             * @param timestamp the parsed timestamp in microseconds since epoch
+             * @return the number of characters consumed, 0 if `data` doesn't start with a timestamp
+             */
+            CASIMIR_EXPORT static cuint parseTimestamp(const char* data, cuint length, int64& timestamp);
+
+            /**
+             * @brief Destructor that releases the mappings of the log file and of the index
+             */
+            CASIMIR_EXPORT ~LogIndex();
+        };
+
+    }
+
+}
+
+#endif
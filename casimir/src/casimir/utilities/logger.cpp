@@ -1,58 +1,535 @@
 #include "logger.hpp"
+#include "concurrent_queue.hpp"
 #include "exception.hpp"
 
 #include <utility>
 #include <iostream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include <system_error>
+#include <cerrno>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
 
 
 namespace Casimir::utilities {
 
-    CASIMIR_EXPORT utilities::LoggerChannelAdapter::~LoggerChannelAdapter() {
-        const String msg = m_parser(m_msg);
-        for (const auto& channel : m_loggerChannel) {
-            channel->log(msg);
+    /**
+     * @brief Parse the message and hand it to every logger channel of the given storage
+     * @param storage the storage of the channel the message has been logged into
+     * @param arguments the captured arguments of the message
+     */
+    static void emitMessage(const __LoggerChannelStorage& storage, const LoggerArguments& arguments) {
+        // The message is only rendered and parsed if at least one of the logger channels requires it, the other
+        // ones receive the typed arguments
+        String parsedMsg;
+        bool parsed = false;
+        for (const auto& channel : storage.channels) {
+            if (channel->expectsRawMessage()) {
+                channel->logArguments(storage.uuid, arguments);
+                continue;
+            }
+            if (!parsed) {
+                parsedMsg = storage.parser(arguments.render(), arguments.time());
+                parsed = true;
+            }
+            channel->logFrom(storage.uuid, parsedMsg);
+        }
+    }
+
+    /**
+     * @brief Messages of an asynchronous logger, kept in a ConcurrentQueue drained by a background thread. Producers
+     * only contend on the enqueue counter of the queue and never on the consumer
+     */
+    class __AsyncLoggerQueue {
+        CASIMIR_DISABLE_COPY_MOVE(__AsyncLoggerQueue);
+    private:
+        /**
+         * @brief Message to be logged, or request of the owner of the queue when `storage` is nullptr: the
+         * background thread sets `flushed` once every message queued before is processed, or stops if `flushed` is
+         * nullptr
+         */
+        struct Message {
+            const __LoggerChannelStorage* storage = nullptr;
+            LoggerArguments arguments;
+            bool* flushed = nullptr;
+        };
+
+        /**
+         * @brief Maximum number of messages popped at once by the background thread
+         */
+        static constexpr cuint s_batchSize = 64;
+
+        const LoggerOverflowPolicy m_overflowPolicy;
+        ConcurrentQueue<Message> m_queue;
+        std::atomic<cuint> m_droppedCount;
+
+        std::mutex m_mutex;
+        std::condition_variable m_flushed;
+        std::thread m_thread;
+
+        void run() {
+            std::vector<Message> messages(s_batchSize);
+            while (true) {
+                cuint count = m_queue.tryPopBatch(messages.data(), s_batchSize);
+                if (count == 0) {
+                    if (!m_queue.tryPopFor(messages[0], std::chrono::milliseconds(10))) continue;
+                    count = 1;
+                }
+
+                for (cuint i = 0; i < count; ++i) {
+                    Message& message = messages[i];
+                    if (message.storage == nullptr) {
+                        // The stop request is the last message queued
+                        if (message.flushed == nullptr) return;
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        *message.flushed = true;
+                        m_flushed.notify_all();
+                        continue;
+                    }
+
+                    // A failing logger channel cannot report to the producer anymore
+                    try {
+                        emitMessage(*message.storage, message.arguments);
+                    } catch (const std::exception& exception) {
+                        std::cerr << exception.what() << std::endl;
+                    }
+                }
+            }
+        }
+
+    public:
+        __AsyncLoggerQueue(cuint capacity, LoggerOverflowPolicy overflowPolicy)
+                : m_overflowPolicy(overflowPolicy), m_queue(capacity), m_droppedCount(0) {
+            m_thread = std::thread(&__AsyncLoggerQueue::run, this);
+        }
+
+        ~__AsyncLoggerQueue() {
+            m_queue.push(Message());
+            m_thread.join();
+        }
+
+        void push(const __LoggerChannelStorage* storage, LoggerArguments& arguments) {
+            switch (m_overflowPolicy) {
+                case LoggerOverflowPolicy::DropAndCount:
+                    if (!m_queue.tryEmplace(Message{storage, std::move(arguments)})) {
+                        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                case LoggerOverflowPolicy::Drop:
+                    m_queue.tryEmplace(Message{storage, std::move(arguments)});
+                    break;
+                case LoggerOverflowPolicy::Block:
+                    m_queue.push(Message{storage, std::move(arguments)});
+                    break;
+            }
+        }
+
+        void flush() {
+            // The queue being ordered, every message queued before the request is processed before it
+            bool flushed = false;
+            m_queue.push(Message{nullptr, LoggerArguments(), &flushed});
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_flushed.wait(lock, [&flushed]() { return flushed; });
+        }
+
+        cuint droppedCount() const {
+            return m_droppedCount.load(std::memory_order_relaxed);
         }
+    };
+
+    CASIMIR_EXPORT LoggerArguments::LoggerArguments(LoggerArguments&& other) noexcept : LoggerArguments() {
+        *this = std::move(other);
+    }
+
+    CASIMIR_EXPORT LoggerArguments& LoggerArguments::operator=(LoggerArguments&& other) noexcept {
+        if (this == &other) return *this;
+        if (other.m_heap) {
+            m_heap = std::move(other.m_heap);
+            m_capacity = other.m_capacity;
+        } else {
+            m_heap.reset();
+            m_capacity = InlineCapacity;
+            std::memcpy(m_inline, other.m_inline, (size_t) other.m_size);
+        }
+        m_size = other.m_size;
+        m_time = other.m_time;
+        other.m_size = 0;
+        other.m_capacity = InlineCapacity;
+        return *this;
+    }
+
+    CASIMIR_EXPORT void LoggerArguments::grow(cuint capacity) {
+        cuint newCapacity = m_capacity * 2;
+        while (newCapacity < capacity) newCapacity *= 2;
+        std::unique_ptr<char[]> heap(new char[newCapacity]);
+        std::memcpy(heap.get(), data(), (size_t) m_size);
+        m_heap = std::move(heap);
+        m_capacity = newCapacity;
+    }
+
+    /**
+     * @brief Read a value of type T stored without alignment at `data`
+     * @param data the bytes of the value
+     * @return the value
+     */
+    template<typename T>
+    static T readValue(const char* data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    CASIMIR_EXPORT void LoggerArguments::render(String& message) const {
+        const char* cursor = m_heap ? m_heap.get() : m_inline;
+        const char* end = cursor + m_size;
+        while (cursor < end) {
+            const auto tag = (Tag) (ubyte) *cursor++;
+            switch (tag) {
+                case Integer:
+                    message.append(String::toString(readValue<cint>(cursor)));
+                    cursor += sizeof(cint);
+                    break;
+                case Unsigned:
+                    message.append(String::toString((cint) readValue<cuint>(cursor)));
+                    cursor += sizeof(cuint);
+                    break;
+                case Float:
+                    message.append(String::toString(readValue<float>(cursor)));
+                    cursor += sizeof(float);
+                    break;
+                case Double:
+                    message.append(String::toString(readValue<double>(cursor)));
+                    cursor += sizeof(double);
+                    break;
+                case Pointer: {
+                    const void* ptr = readValue<const void*>(cursor);
+                    message.append(String((char*) &ptr, sizeof(void*)).encodeToHex());
+                    cursor += sizeof(void*);
+                    break;
+                }
+                case Text: {
+                    const cuint length = readValue<cuint>(cursor);
+                    cursor += sizeof(cuint);
+                    message.append(cursor, length);
+                    cursor += length;
+                    break;
+                }
+            }
+        }
+    }
+
+    CASIMIR_EXPORT String LoggerArguments::render() const {
+        String message;
+        render(message);
+        return message;
+    }
+
+    CASIMIR_EXPORT void utilities::AbstractLoggerChannel::logFrom(const Uuid&, const String& msg) {
+        log(msg);
+    }
+
+    CASIMIR_EXPORT void utilities::AbstractLoggerChannel::logArguments(const Uuid& channel,
+                                                                       const LoggerArguments& arguments) {
+        logFrom(channel, arguments.render());
+    }
+
+    CASIMIR_EXPORT bool utilities::AbstractLoggerChannel::expectsRawMessage() const {
+        return false;
     }
 
     CASIMIR_EXPORT utilities::AbstractLoggerChannel::~AbstractLoggerChannel() = default;
 
+    /**
+     * @brief Per-channel state of the rate limit and of the coalescing of repeated messages. Only instantiated for
+     * the channels that require it so that the other ones never take its lock
+     */
+    class __LoggerChannelLimiter {
+        CASIMIR_DISABLE_COPY_MOVE(__LoggerChannelLimiter);
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        const double m_rate;
+        const double m_burst;
+        const bool m_coalesceRepeats;
+
+        std::mutex m_mutex;
+        double m_tokens;
+        Clock::time_point m_lastRefill;
+        cuint m_suppressed;
+        std::string m_lastMessage;
+        cuint m_repeats;
+
+        /**
+         * @brief Build the record telling how many times the last message has been repeated
+         * @param summaries the summaries the record is appended to
+         */
+        void takeRepeats(std::vector<LoggerArguments>& summaries) {
+            if (m_repeats == 0) return;
+            summaries.emplace_back();
+            const String text = "Last message repeated " + String::toString((cint) m_repeats).str() +
+                                (m_repeats == 1 ? " time" : " times");
+            summaries.back().appendText(text.c_str(), text.length());
+            m_repeats = 0;
+        }
+
+        /**
+         * @brief Build the record telling how many messages have been suppressed by the rate limit
+         * @param summaries the summaries the record is appended to
+         */
+        void takeSuppressed(std::vector<LoggerArguments>& summaries) {
+            if (m_suppressed == 0) return;
+            summaries.emplace_back();
+            const String text = String::toString((cint) m_suppressed).str() +
+                                (m_suppressed == 1 ? " message" : " messages") + " suppressed by the rate limit";
+            summaries.back().appendText(text.c_str(), text.length());
+            m_suppressed = 0;
+        }
+
+    public:
+        __LoggerChannelLimiter(cuint rate, cuint burst, bool coalesceRepeats)
+                : m_rate((double) rate), m_burst((double) std::max<cuint>(burst, 1)),
+                  m_coalesceRepeats(coalesceRepeats), m_tokens(m_burst), m_lastRefill(Clock::now()),
+                  m_suppressed(0), m_repeats(0) {}
+
+        /**
+         * @brief Decide whether or not `arguments` must be logged
+         * @param arguments the message logged into the channel
+         * @param summaries the records that must be logged before the message
+         * @return true if the message must be logged
+         */
+        bool admit(const LoggerArguments& arguments, std::vector<LoggerArguments>& summaries) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // A repeated message neither consumes a token nor is logged
+            if (m_coalesceRepeats) {
+                if (m_lastMessage.size() == arguments.size() &&
+                    std::memcmp(m_lastMessage.data(), arguments.data(), (size_t) arguments.size()) == 0) {
+                    ++m_repeats;
+                    return false;
+                }
+            }
+
+            if (m_rate > 0) {
+                const Clock::time_point now = Clock::now();
+                m_tokens = std::min(m_burst, m_tokens + m_rate * std::chrono::duration<double>(now - m_lastRefill).count());
+                m_lastRefill = now;
+                if (m_tokens < 1) {
+                    ++m_suppressed;
+                    return false;
+                }
+                m_tokens -= 1;
+            }
+
+            takeRepeats(summaries);
+            takeSuppressed(summaries);
+            if (m_coalesceRepeats) m_lastMessage.assign(arguments.data(), (size_t) arguments.size());
+            return true;
+        }
+
+        /**
+         * @brief Take the summaries still pending (when the Logger is flushed or destroyed)
+         * @param summaries the records that must be logged
+         */
+        void takePending(std::vector<LoggerArguments>& summaries) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            takeRepeats(summaries);
+            takeSuppressed(summaries);
+        }
+    };
+
     class __Logger {
         CASIMIR_DISABLE_COPY_MOVE(__Logger);
     private:
-        std::unordered_map<Uuid, Logger::__LoggerChannelStorage> m_channels;
+        std::unordered_map<Uuid, __LoggerChannelStorage> m_channels;
+        std::unique_ptr<std::atomic<uint64>[]> m_enabledMask;
+        std::unique_ptr<__AsyncLoggerQueue> m_queue;
+
+        void send(const __LoggerChannelStorage& storage, LoggerArguments& arguments) const {
+            if (m_queue) {
+                // The message keeps the time of the call site, not the one of its emission
+                arguments.setTime(std::chrono::system_clock::now());
+                m_queue->push(&storage, arguments);
+            } else {
+                // The message is emitted from the destructor of LoggerChannelAdapter which cannot throw
+                try {
+                    emitMessage(storage, arguments);
+                } catch (const std::exception& exception) {
+                    std::cerr << exception.what() << std::endl;
+                }
+            }
+        }
+
+        void emitPendingSummaries() const {
+            for (const auto& channel : m_channels) {
+                if (!channel.second.limiter) continue;
+                std::vector<LoggerArguments> summaries;
+                channel.second.limiter->takePending(summaries);
+                for (auto& summary : summaries) send(channel.second, summary);
+            }
+        }
 
     public:
+        CASIMIR_EXPORT const __LoggerChannelStorage* find(const Uuid& uuid) const {
+            auto it = m_channels.find(uuid);
+            return it == m_channels.end() ? nullptr : &it->second;
+        }
+
         CASIMIR_EXPORT explicit __Logger(
-                std::unordered_map<Uuid, Logger::__LoggerChannelStorage> channels)
-                : m_channels(std::move(channels)) {
+                std::unordered_map<Uuid, __LoggerChannelStorage> channels,
+                cuint asyncCapacity, LoggerOverflowPolicy overflowPolicy)
+                : m_channels(std::move(channels)), m_enabledMask(new std::atomic<uint64>[m_channels.size() / 64 + 1]) {
+            // Each channel owns one bit of the enable mask. Channels without any logger channel start disabled
+            for (cuint i = 0; i <= m_channels.size() / 64; ++i) {
+                m_enabledMask[i].store(0, std::memory_order_relaxed);
+            }
+            cuint index = 0;
+            for (auto& channel : m_channels) {
+                channel.second.index = index++;
+                if (!channel.second.channels.empty()) {
+                    m_enabledMask[channel.second.index / 64].fetch_or(1ULL << (channel.second.index % 64));
+                }
+                if (channel.second.rateLimit != 0 || channel.second.coalesceRepeats) {
+                    channel.second.limiter = std::make_shared<__LoggerChannelLimiter>(
+                            channel.second.rateLimit, channel.second.rateBurst, channel.second.coalesceRepeats);
+                }
+            }
+
+            if (asyncCapacity != 0) {
+                m_queue = std::make_unique<__AsyncLoggerQueue>(asyncCapacity, overflowPolicy);
+            }
+        }
+
+        CASIMIR_EXPORT bool isEnabled(const __LoggerChannelStorage& storage) const {
+            return (m_enabledMask[storage.index / 64].load(std::memory_order_relaxed) >> (storage.index % 64)) & 1ULL;
+        }
 
+        CASIMIR_EXPORT bool isEnabled(const Uuid& uuid) const {
+            const __LoggerChannelStorage* storage = find(uuid);
+            return storage && isEnabled(*storage);
+        }
+
+        CASIMIR_EXPORT void setEnabled(const Uuid& uuid, bool enabled) {
+            const __LoggerChannelStorage* storage = find(uuid);
+            if (!storage || storage->channels.empty()) return;
+            const uint64 bit = 1ULL << (storage->index % 64);
+            if (enabled) {
+                m_enabledMask[storage->index / 64].fetch_or(bit, std::memory_order_relaxed);
+            } else {
+                m_enabledMask[storage->index / 64].fetch_and(~bit, std::memory_order_relaxed);
+            }
         }
 
         CASIMIR_EXPORT LoggerChannelAdapter get(const Uuid& uuid) const {
-            auto it = m_channels.find(uuid);
-            if (it == m_channels.end()) {
-                return LoggerChannelAdapter([](const String& a){ return a; }, {});
+            const __LoggerChannelStorage* storage = find(uuid);
+            if (!storage || !isEnabled(*storage)) {
+                return LoggerChannelAdapter(this, nullptr);
+            }
+            return LoggerChannelAdapter(this, storage);
+        }
+
+        CASIMIR_EXPORT ~__Logger() {
+            emitPendingSummaries();
+        }
+
+        CASIMIR_EXPORT void dispatch(const __LoggerChannelStorage& storage, LoggerArguments& arguments) const {
+            if (storage.limiter) {
+                std::vector<LoggerArguments> summaries;
+                if (!storage.limiter->admit(arguments, summaries)) return;
+                for (auto& summary : summaries) send(storage, summary);
             }
-            return LoggerChannelAdapter(it->second.parser, it->second.channels);
+            send(storage, arguments);
+        }
+
+        CASIMIR_EXPORT void flush() const {
+            emitPendingSummaries();
+            if (m_queue) m_queue->flush();
+        }
+
+        CASIMIR_EXPORT cuint droppedCount() const {
+            return m_queue ? m_queue->droppedCount() : 0;
+        }
+
+        CASIMIR_EXPORT bool isAsynchronous() const {
+            return (bool) m_queue;
         }
     };
 
+    CASIMIR_EXPORT utilities::LoggerChannelAdapter::~LoggerChannelAdapter() {
+        if (m_storage) {
+            m_logger->dispatch(*m_storage, m_arguments);
+        }
+    }
+
     CASIMIR_EXPORT Logger::Logger(
-            const std::unordered_map<Uuid, __LoggerChannelStorage>& channels) {
-        m_handle = std::make_shared<__Logger>(channels);
+            const std::unordered_map<Uuid, __LoggerChannelStorage>& channels,
+            cuint asyncCapacity, LoggerOverflowPolicy overflowPolicy) {
+        m_handle = std::make_shared<__Logger>(channels, asyncCapacity, overflowPolicy);
+    }
+
+    CASIMIR_EXPORT bool LoggerChannelHandle::isEnabled() const {
+        return m_storage && m_logger->isEnabled(*m_storage);
+    }
+
+    CASIMIR_EXPORT LoggerChannelAdapter LoggerChannelHandle::operator()() const {
+        return LoggerChannelAdapter(m_logger.get(), isEnabled() ? m_storage : nullptr);
+    }
+
+    CASIMIR_EXPORT LoggerChannelHandle Logger::resolve(const Uuid& uuid) const {
+        return LoggerChannelHandle(m_handle, m_handle->find(uuid));
     }
 
     CASIMIR_EXPORT LoggerChannelAdapter Logger::at(const Uuid& uuid) const {
         return m_handle->get(uuid);
     }
 
+    CASIMIR_EXPORT bool Logger::isEnabled(const Uuid& uuid) const {
+        return m_handle->isEnabled(uuid);
+    }
+
+    CASIMIR_EXPORT void Logger::setEnabled(const Uuid& uuid, bool enabled) {
+        m_handle->setEnabled(uuid, enabled);
+    }
+
+    CASIMIR_EXPORT void Logger::flush() const {
+        m_handle->flush();
+    }
+
+    CASIMIR_EXPORT cuint Logger::droppedCount() const {
+        return m_handle->droppedCount();
+    }
+
+    CASIMIR_EXPORT bool Logger::isAsynchronous() const {
+        return m_handle->isAsynchronous();
+    }
+
     CASIMIR_EXPORT LoggerBuilder& LoggerBuilder::registerChannelAt(const Uuid& uuid,
                                                                    const std::shared_ptr<AbstractLoggerChannel>& channel,
                                                                    const std::function<String(const String&)>& parser) {
+        return registerChannelAt(uuid, channel, [parser](const String& msg, std::chrono::system_clock::time_point) {
+            return parser(msg);
+        });
+    }
+
+    CASIMIR_EXPORT LoggerBuilder& LoggerBuilder::registerChannelAt(
+            const Uuid& uuid, const std::shared_ptr<AbstractLoggerChannel>& channel,
+            const std::function<String(const String&, std::chrono::system_clock::time_point)>& parser) {
         auto it = m_channels.find(uuid);
         if (it == m_channels.end()) {
-            m_channels.insert(std::make_pair(uuid, Logger::__LoggerChannelStorage{
-                std::vector<std::shared_ptr<AbstractLoggerChannel>>{channel},parser
+            m_channels.insert(std::make_pair(uuid, __LoggerChannelStorage{
+                uuid, 0, std::vector<std::shared_ptr<AbstractLoggerChannel>>{channel}, parser, 0, 0, false, nullptr
             }));
         } else {
             it->second.channels.push_back(channel);
@@ -60,46 +537,263 @@ namespace Casimir::utilities {
         return *this;
     }
 
+    CASIMIR_EXPORT LoggerBuilder& LoggerBuilder::setAsynchronous(cuint capacity, LoggerOverflowPolicy overflowPolicy) {
+        m_asyncCapacity = capacity;
+        m_overflowPolicy = overflowPolicy;
+        return *this;
+    }
+
+    CASIMIR_EXPORT LoggerBuilder& LoggerBuilder::setRateLimit(const Uuid& uuid, cuint messagesPerSecond, cuint burst) {
+        auto it = m_channels.find(uuid);
+        if (it == m_channels.end()) {
+            CASIMIR_THROW_EXCEPTION("InvalidArgument", "Cannot limit a channel that hasn't been registered");
+        }
+        it->second.rateLimit = messagesPerSecond;
+        it->second.rateBurst = burst;
+        return *this;
+    }
+
+    CASIMIR_EXPORT LoggerBuilder& LoggerBuilder::setRepeatCoalescing(const Uuid& uuid, bool enabled) {
+        auto it = m_channels.find(uuid);
+        if (it == m_channels.end()) {
+            CASIMIR_THROW_EXCEPTION("InvalidArgument", "Cannot coalesce the messages of a channel that hasn't been registered");
+        }
+        it->second.coalesceRepeats = enabled;
+        return *this;
+    }
+
     CASIMIR_EXPORT Logger LoggerBuilder::create() const {
-        return Logger(m_channels);
+        return Logger(m_channels, m_asyncCapacity, m_overflowPolicy);
+    }
+
+    /**
+     * @brief Write the whole `data` to the file descriptor `fd` (retry on partial write)
+     * @param fd the file descriptor
+     * @param data the bytes to be written
+     * @param size the number of bytes to be written
+     * @throw Casimir::Exception if a write fails or doesn't make any progress, the rest of `data` is lost
+     */
+    static void writeAll(int fd, const char* data, size_t size) {
+        while (size != 0) {
+#ifdef _WIN32
+            const int written = _write(fd, data, (unsigned int) size);
+#else
+            const ssize_t written = ::write(fd, data, size);
+            if (written < 0 && errno == EINTR) continue;
+#endif
+            if (written <= 0) {
+                const int error = written < 0 ? errno : EIO;
+                const String what = std::system_error(error, std::system_category(),
+                        "Cannot write " + std::to_string(size) + " bytes of log to the descriptor "
+                        + std::to_string(fd)).what();
+                CASIMIR_THROW_EXCEPTION("SystemException", what);
+            }
+            data += written;
+            size -= (size_t) written;
+        }
+    }
+
+    CASIMIR_EXPORT void __PeriodicFlusher::start(std::chrono::milliseconds interval, std::function<void()> flush) {
+        m_thread = std::thread([this, interval, flush = std::move(flush)]() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_stop) {
+                m_wakeUp.wait_for(lock, interval);
+                if (m_stop) break;
+                // Nobody waits for the result of a periodic flush
+                try {
+                    flush();
+                } catch (const std::exception& exception) {
+                    std::cerr << exception.what() << std::endl;
+                }
+            }
+        });
+    }
+
+    CASIMIR_EXPORT void __PeriodicFlusher::stop() {
+        if (!m_thread.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_wakeUp.notify_one();
+        }
+        m_thread.join();
     }
 
-    CASIMIR_EXPORT ShellLogger::ShellLogger() = default;
+    CASIMIR_EXPORT ShellLogger::ShellLogger()
+            : m_mutex("ShellLogger"), m_fd(-1), m_lineBuffered(false), m_bufferSize(0), m_flushInterval(0) {}
+
+    CASIMIR_EXPORT ShellLogger::ShellLogger(ShellLoggerStream stream, ShellLoggerBuffering buffering, cuint bufferSize,
+                                            std::chrono::milliseconds flushInterval)
+            : m_mutex("ShellLogger"), m_bufferSize(bufferSize), m_flushInterval(flushInterval) {
+#ifdef _WIN32
+        m_fd = stream == ShellLoggerStream::Stdout ? 1 : 2;
+        const bool terminal = _isatty(m_fd) != 0;
+#else
+        m_fd = stream == ShellLoggerStream::Stdout ? STDOUT_FILENO : STDERR_FILENO;
+        const bool terminal = isatty(m_fd) != 0;
+#endif
+        // Someone watching a terminal wants every line as soon as possible, a collector reading a pipe does not
+        m_lineBuffered = buffering == ShellLoggerBuffering::Line || (buffering == ShellLoggerBuffering::Auto && terminal);
+        m_buffer.reserve(m_bufferSize);
+
+        if (!m_lineBuffered && m_bufferSize != 0 && m_flushInterval.count() > 0) {
+            m_flusher.start(m_flushInterval, [this]() { flush(); });
+        }
+    }
+
+    void ShellLogger::flushBuffer() {
+        try {
+            writeAll(m_fd, m_buffer.data(), m_buffer.size());
+        } catch (const Exception&) {
+            m_buffer.clear();
+            throw;
+        }
+        m_buffer.clear();
+    }
 
     CASIMIR_EXPORT void ShellLogger::log(const String& msg) {
         m_mutex.acquireLock();
-        std::cout << msg.str();
+        try {
+            if (m_fd < 0) {
+                std::cout.write(msg.c_str(), (std::streamsize) msg.length());
+            } else {
+                if (m_buffer.size() + msg.length() > m_bufferSize) {
+                    flushBuffer();
+                }
+                if (msg.length() >= m_bufferSize) { // Would not fit in the buffer anyway
+                    writeAll(m_fd, msg.c_str(), (size_t) msg.length());
+                } else {
+                    m_buffer.insert(m_buffer.end(), msg.c_str(), msg.c_str() + msg.length());
+                    if (m_lineBuffered && std::memchr(msg.c_str(), '\n', (size_t) msg.length()) != nullptr) {
+                        flushBuffer();
+                    }
+                }
+            }
+        } catch (const Exception&) {
+            m_mutex.releaseLock();
+            throw;
+        }
         m_mutex.releaseLock();
     }
 
+    CASIMIR_EXPORT void ShellLogger::flush() {
+        m_mutex.acquireLock();
+        try {
+            if (m_fd < 0) {
+                std::cout.flush();
+            } else {
+                flushBuffer();
+            }
+        } catch (const Exception&) {
+            m_mutex.releaseLock();
+            throw;
+        }
+        m_mutex.releaseLock();
+    }
+
+    CASIMIR_EXPORT bool ShellLogger::isLineBuffered() const {
+        return m_lineBuffered;
+    }
+
+    CASIMIR_EXPORT ShellLogger::~ShellLogger() {
+        m_flusher.stop();
+        try {
+            if (m_fd >= 0) flushBuffer();
+        } catch (const Exception& exception) {
+            std::cerr << exception.what() << std::endl;
+        }
+    }
+
     CASIMIR_EXPORT FileLogger::FileLogger(const String& filepath)
-            : m_fstream(new std::fstream()) {
-        m_fstream->open(filepath.c_str(), std::ios_base::out | std::ios_base::app);
-        if (!m_fstream->is_open()) { // In case of any exception
+            : FileLogger(filepath, 0, std::chrono::milliseconds(0)) {}
+
+    CASIMIR_EXPORT FileLogger::FileLogger(const String& filepath, cuint bufferSize,
+                                          std::chrono::milliseconds flushInterval, std::vector<Uuid> immediateChannels)
+            : m_mutex("FileLogger"), m_bufferSize(bufferSize), m_immediateChannels(std::move(immediateChannels)),
+              m_flushInterval(flushInterval) {
+#ifdef _WIN32
+        m_fd = _open(filepath.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        m_fd = open(filepath.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+#endif
+        if (m_fd < 0) { // In case of any exception
             const String what = std::system_error(errno, std::system_category(),
                                                   "Cannot open file " + filepath.str()).what();
-            // Delete the file stream
-            delete m_fstream;
-            m_fstream = nullptr;
-
-            // Throw the exception
             CASIMIR_THROW_EXCEPTION("SystemException", what);
         }
+        m_buffer.reserve(m_bufferSize);
+
+        // The periodic flush is only required when messages can stay in the buffer
+        if (m_bufferSize != 0 && m_flushInterval.count() > 0) {
+            m_flusher.start(m_flushInterval, [this]() { flush(); });
+        }
     }
 
-    CASIMIR_EXPORT void FileLogger::log(const String& msg) {
+    void FileLogger::flushBuffer() {
+        try {
+            writeAll(m_fd, m_buffer.data(), m_buffer.size());
+        } catch (const Exception&) {
+            m_buffer.clear();
+            throw;
+        }
+        m_buffer.clear();
+    }
+
+    void FileLogger::write(const String& msg, bool immediate) {
 #ifdef CASIMIR_SAFE_CHECK
-        if(!m_fstream) {
+        if(m_fd < 0) {
             CASIMIR_THROW_EXCEPTION("InvalidUsage", "Cannot call the log function after the FileLogger constructor failed");
         }
 #endif
-        m_fstream->write(msg.c_str(), msg.length());
-        m_fstream->flush();
+        m_mutex.acquireLock();
+        try {
+            if (m_buffer.size() + msg.length() > m_bufferSize) {
+                flushBuffer();
+            }
+            if (msg.length() >= m_bufferSize) { // Would not fit in the buffer anyway
+                writeAll(m_fd, msg.c_str(), (size_t) msg.length());
+            } else {
+                m_buffer.insert(m_buffer.end(), msg.c_str(), msg.c_str() + msg.length());
+                if (immediate) flushBuffer();
+            }
+        } catch (const Exception&) {
+            m_mutex.releaseLock();
+            throw;
+        }
+        m_mutex.releaseLock();
+    }
+
+    CASIMIR_EXPORT void FileLogger::log(const String& msg) {
+        write(msg, false);
+    }
+
+    CASIMIR_EXPORT void FileLogger::logFrom(const Uuid& channel, const String& msg) {
+        write(msg, std::find(m_immediateChannels.begin(), m_immediateChannels.end(), channel) != m_immediateChannels.end());
+    }
+
+    CASIMIR_EXPORT void FileLogger::flush() {
+        m_mutex.acquireLock();
+        try {
+            flushBuffer();
+        } catch (const Exception&) {
+            m_mutex.releaseLock();
+            throw;
+        }
+        m_mutex.releaseLock();
     }
 
     CASIMIR_EXPORT FileLogger::~FileLogger() {
-        m_fstream->close();
-        delete m_fstream;
+        m_flusher.stop();
+        try {
+            flushBuffer();
+        } catch (const Exception& exception) {
+            std::cerr << exception.what() << std::endl;
+        }
+#ifdef _WIN32
+        _close(m_fd);
+#else
+        close(m_fd);
+#endif
     }
 
 };
@@ -6,13 +6,39 @@
 #include <memory>
 #include <type_traits>
 #include <functional>
-#include <fstream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
 
 #include "../casimir.hpp"
 #include "string.hpp"
 #include "uuid.hpp"
 #include "cmutex.hpp"
 
+/**
+ * @brief Log into the channel `uuid` of `logger` only if the channel is enabled. When the channel is disabled (or
+ * when `level` is below CASIMIR_LOG_MIN_LEVEL) the streamed arguments are not evaluated at all
+ * @note The channel is looked up once per call, use CASIMIR_LOG_HANDLE on hot paths to skip the lookup as well
+ * @note The macro expands to a single `if (...) {} else` statement so that an `else` following it belongs to the
+ * caller's `if`
+ * @example CASIMIR_LOG(logger, Casimir::utilities::LoggerLevel::Info, PrivateLogging::Info) << "value " << value;
+ */
+#define CASIMIR_LOG(logger, level, uuid) \
+    if (Casimir::utilities::LoggerChannelAdapter casimirLogAdapter = \
+            (Casimir::cint) (level) >= CASIMIR_LOG_MIN_LEVEL ? (logger)(uuid) \
+                : Casimir::utilities::LoggerChannelAdapter::disabled(); \
+        !casimirLogAdapter.isEnabled()) {} else casimirLogAdapter
+
+/**
+ * @brief Same as CASIMIR_LOG but through a resolved Casimir::utilities::LoggerChannelHandle
+ * @example CASIMIR_LOG_HANDLE(infoHandle, Casimir::utilities::LoggerLevel::Info) << "value " << value;
+ */
+#define CASIMIR_LOG_HANDLE(handle, level) \
+    if (!((Casimir::cint) (level) >= CASIMIR_LOG_MIN_LEVEL && (handle).isEnabled())) {} else (handle)()
+
 namespace Casimir {
 
     namespace utilities {
@@ -20,6 +46,84 @@ namespace Casimir {
         class Logger;
         class __Logger;
         class LoggerBuilder;
+        class AbstractLoggerChannel;
+        class LoggerArguments;
+        class __LoggerChannelLimiter;
+
+        /**
+         * @brief Internal storage class that store a list of channels logger as long as a
+         * parsing function for each channel.
+         */
+        struct __LoggerChannelStorage {
+            Uuid uuid;
+            cuint index;
+            std::vector<std::shared_ptr<AbstractLoggerChannel>> channels;
+            std::function<String(const String&, std::chrono::system_clock::time_point)> parser; // Message, log time
+            cuint rateLimit;      // Messages per second (0 when not limited)
+            cuint rateBurst;      // Capacity of the token bucket
+            bool coalesceRepeats; // Whether identical consecutive messages are merged
+            std::shared_ptr<__LoggerChannelLimiter> limiter; // Instantiated by the Logger when required
+        };
+
+        /**
+         * @brief Severity of a log call site. Call sites made through CASIMIR_LOG with a level strictly lower than
+         * CASIMIR_LOG_MIN_LEVEL are removed at compile time
+         */
+        enum class LoggerLevel : cint {
+            Note    = 0,
+            Info    = 1,
+            Warning = 2,
+            Error   = 3
+        };
+
+        /**
+         * @brief Defines the behavior of an asynchronous Logger when its internal queue is full
+         */
+        enum class LoggerOverflowPolicy {
+            /**
+             * @brief The producer thread waits until the background thread has made some room in the queue
+             */
+            Block,
+
+            /**
+             * @brief The message is silently discarded
+             */
+            Drop,
+
+            /**
+             * @brief The message is discarded and the number of discarded messages is kept
+             * (see Logger::droppedCount)
+             */
+            DropAndCount
+        };
+
+        /**
+         * @brief The standard stream a direct ShellLogger writes to
+         */
+        enum class ShellLoggerStream {
+            Stdout,
+            Stderr
+        };
+
+        /**
+         * @brief Defines when a direct ShellLogger hands its buffered messages to the operating system
+         */
+        enum class ShellLoggerBuffering {
+            /**
+             * @brief Line buffering when the stream is a terminal, block buffering otherwise (pipe, file, ...)
+             */
+            Auto,
+
+            /**
+             * @brief Every complete line is written right away
+             */
+            Line,
+
+            /**
+             * @brief The messages are written by a single call once the buffer is full or every flush interval
+             */
+            Block
+        };
 
         /**
          * @brief An abstract interface that defines the behavior awaiting by an LoggerChannel
@@ -33,46 +137,277 @@ namespace Casimir {
              */
             virtual void log(const String& msg) = 0;
 
+            /**
+             * @brief Handle a utilities::String `msg` logged into the channel registered under `channel`. By default
+             * simply forward the message to AbstractLoggerChannel::log
+             * @param channel the Uuid of the channel the message has been logged into
+             * @param msg the message to be handled by the LoggerChannel.
+             */
+            CASIMIR_EXPORT virtual void logFrom(const Uuid& channel, const String& msg);
+
+            /**
+             * @brief Handle the arguments captured for a message logged into the channel registered under `channel`,
+             * called instead of AbstractLoggerChannel::logFrom when the channel expects raw messages. By default
+             * render the arguments to text and forward them to AbstractLoggerChannel::logFrom
+             * @param channel the Uuid of the channel the message has been logged into
+             * @param arguments the typed arguments of the message (see LoggerArguments)
+             */
+            CASIMIR_EXPORT virtual void logArguments(const Uuid& channel, const LoggerArguments& arguments);
+
+            /**
+             * @brief Whether or not the channel must receive the captured arguments of the message (see
+             * AbstractLoggerChannel::logArguments) instead of the message formatted by the parser of the Logger channel
+             * (for instance to store the arguments in a binary format and format them offline)
+             * @return false by default
+             */
+            CASIMIR_EXPORT virtual bool expectsRawMessage() const;
+
             /**
              * @brief Default virtual destructor for the AbstractLoggerChannel
              */
             CASIMIR_EXPORT virtual ~AbstractLoggerChannel();
         };
 
+        /**
+         * @brief Compact typed buffer holding the arguments streamed into a LoggerChannelAdapter. Each argument is
+         * stored as a one byte tag followed by its raw value so that the conversion to text is deferred until the
+         * message is emitted (possibly by the background thread of an asynchronous Logger)
+         * @note Numbers and pointers never allocate as long as the arguments fit in the inline storage
+         */
+        class LoggerArguments {
+            CASIMIR_DISABLE_COPY(LoggerArguments)
+        public:
+            /**
+             * @brief Tag written before each argument
+             */
+            enum Tag : ubyte {
+                Integer  = 'i', // int64
+                Unsigned = 'u', // uint64
+                Float    = 'f', // float
+                Double   = 'd', // double
+                Pointer  = 'p', // const void*
+                Text     = 's'  // cuint length followed by the bytes of the String
+            };
+
+            /**
+             * @brief Number of bytes stored in the object itself before falling back to the heap
+             */
+            static constexpr cuint InlineCapacity = 112;
+
+        private:
+            cuint m_size;
+            cuint m_capacity;
+            std::unique_ptr<char[]> m_heap;
+            std::chrono::system_clock::time_point m_time; // Epoch until the time is recorded (see setTime)
+            char m_inline[InlineCapacity];
+
+            /**
+             * @brief Move the arguments to a heap buffer able to hold at least `capacity` bytes
+             * @param capacity the minimal number of bytes required
+             */
+            CASIMIR_EXPORT void grow(cuint capacity);
+
+            /**
+             * @brief Reserve `size` bytes at the end of the buffer
+             * @param size the number of bytes to reserve
+             * @return A pointer to the reserved bytes
+             */
+            inline char* extend(cuint size) {
+                if (m_size + size > m_capacity) grow(m_size + size);
+                char* result = data() + m_size;
+                m_size += size;
+                return result;
+            }
+
+            /**
+             * @brief Append a tag followed by the raw bytes of `value`
+             * @param tag the tag of the argument
+             * @param value the value of the argument
+             */
+            template<typename T>
+            inline void appendValue(Tag tag, const T& value) {
+                char* destination = extend(1 + sizeof(T));
+                destination[0] = (char) tag;
+                std::memcpy(destination + 1, &value, sizeof(T));
+            }
+
+            inline char* data() {
+                return m_heap ? m_heap.get() : m_inline;
+            }
+
+        public:
+            /**
+             * @brief Construct an empty buffer of arguments
+             */
+            inline LoggerArguments() : m_size(0), m_capacity(InlineCapacity), m_time() {}
+
+            /**
+             * @brief Move constructor of LoggerArguments. Only the used inline bytes are copied
+             * @param other the arguments to be moved
+             */
+            CASIMIR_EXPORT LoggerArguments(LoggerArguments&& other) noexcept;
+
+            /**
+             * @brief Move assignment of LoggerArguments. Only the used inline bytes are copied
+             * @param other the arguments to be moved
+             * @return A self-reference
+             */
+            CASIMIR_EXPORT LoggerArguments& operator=(LoggerArguments&& other) noexcept;
+
+            /**
+             * @brief Append an Integer argument
+             * @param value the integer to be appended
+             */
+            inline void appendInteger(cint value) {
+                appendValue(Integer, value);
+            }
+
+            /**
+             * @brief Append an Unsigned argument
+             * @param value the unsigned integer to be appended
+             */
+            inline void appendUnsigned(cuint value) {
+                appendValue(Unsigned, value);
+            }
+
+            /**
+             * @brief Append a Float argument
+             * @param value the float to be appended
+             */
+            inline void appendFloat(float value) {
+                appendValue(Float, value);
+            }
+
+            /**
+             * @brief Append a Double argument
+             * @param value the double to be appended
+             */
+            inline void appendDouble(double value) {
+                appendValue(Double, value);
+            }
+
+            /**
+             * @brief Append a Pointer argument
+             * @param ptr the pointer to be appended
+             */
+            inline void appendPointer(const void* ptr) {
+                appendValue(Pointer, ptr);
+            }
+
+            /**
+             * @brief Append a Text argument. The bytes are copied since the text may not outlive the call site
+             * @param text the bytes of the text
+             * @param length the number of bytes of the text
+             */
+            inline void appendText(const char* text, cuint length) {
+                char* destination = extend(1 + sizeof(cuint) + length);
+                destination[0] = (char) Text;
+                std::memcpy(destination + 1, &length, sizeof(cuint));
+                std::memcpy(destination + 1 + sizeof(cuint), text, (size_t) length);
+            }
+
+            /**
+             * @brief Record the time the message has been logged at. An asynchronous Logger records it before
+             * queuing the message so that it doesn't become the time the message has been emitted at
+             * @param time the time of the call site
+             */
+            inline void setTime(std::chrono::system_clock::time_point time) {
+                m_time = time;
+            }
+
+            /**
+             * @brief The time the message has been logged at: the recorded one (see setTime) or the current time
+             * otherwise (a synchronous Logger emits the message from the call site)
+             * @return the time of the message
+             */
+            inline std::chrono::system_clock::time_point time() const {
+                return m_time != std::chrono::system_clock::time_point() ? m_time : std::chrono::system_clock::now();
+            }
+
+            /**
+             * @brief Number of bytes used by the arguments
+             * @return the number of bytes used by the arguments
+             */
+            inline cuint size() const {
+                return m_size;
+            }
+
+            /**
+             * @brief The encoded arguments (see LoggerArguments::Tag)
+             * @return A pointer to the size() bytes of the arguments
+             */
+            inline const char* data() const {
+                return m_heap ? m_heap.get() : m_inline;
+            }
+
+            /**
+             * @brief Convert the arguments to text, as they would have been appended one after the other
+             * @param message the String the text is appended to
+             */
+            CASIMIR_EXPORT void render(String& message) const;
+
+            /**
+             * @brief Convert the arguments to text
+             * @return the resulting message
+             */
+            CASIMIR_EXPORT String render() const;
+        };
+
         /**
          * @brief An LoggerChannelAdapter is an class that adapt a LoggerChannel to be used from anyone. It enable
          * the user to log data directly into the LoggerChannel without having to deal with conversion...
+         * @note The arguments are only captured (see LoggerArguments), the conversion to text happens when the
+         * message is emitted
          */
         class LoggerChannelAdapter {
             CASIMIR_DISABLE_COPY(LoggerChannelAdapter)
             friend class __Logger;
+            friend class LoggerChannelHandle;
         private:
-            std::function<String(const String&)> m_parser;
-            std::vector<std::shared_ptr<AbstractLoggerChannel>> m_loggerChannel;
-            String m_msg;
+            const __Logger* m_logger;
+            const __LoggerChannelStorage* m_storage;
+            LoggerArguments m_arguments;
 
             /**
              * @brief Private internal constructor of LoggerChannelAdapter
-             * @param parser the function used to parse the resulting log
-             * @param loggerChannel A list of all the logger channel linked to the current channel
+             * @param logger the logger that will dispatch the resulting message
+             * @param storage the storage of the channel (parser and logger channels). If nullptr the message is
+             * discarded
              */
-            inline explicit LoggerChannelAdapter(std::function<String(const String&)> parser,
-                                                 std::vector<std::shared_ptr<AbstractLoggerChannel>> loggerChannel)
-            : m_parser(std::move(parser)), m_loggerChannel(std::move(loggerChannel)), m_msg("") {}
+            inline explicit LoggerChannelAdapter(const __Logger* logger, const __LoggerChannelStorage* storage)
+            : m_logger(logger), m_storage(storage) {}
         public:
             /**
              * @brief Destructor of the LoggerChannelAdapter. Notice that it is during the destruction operation that
-             * the logging process take place.
+             * the logging process take place (or that the message is handed to the background thread if the Logger
+             * is asynchronous).
              */
             CASIMIR_EXPORT ~LoggerChannelAdapter();
 
+            /**
+             * @brief Create a LoggerChannelAdapter that discards everything (see CASIMIR_LOG)
+             * @return A disabled LoggerChannelAdapter
+             */
+            inline static LoggerChannelAdapter disabled() {
+                return LoggerChannelAdapter(nullptr, nullptr);
+            }
+
+            /**
+             * @brief Whether or not the message will be handed to any logger channel. When false every operator<<
+             * is a no-op
+             * @return true if the channel exists, is enabled and has at least one logger channel
+             */
+            inline bool isEnabled() const {
+                return m_storage != nullptr;
+            }
+
             /**
              * @brief Append a String to the end of the current logging message
              * @param str the String to be appended
              * @return A self-reference
              */
             inline LoggerChannelAdapter& operator<<(const String& str) {
-                m_msg.append(str);
+                if (m_storage) m_arguments.appendText(str.c_str(), str.length());
                 return *this;
             }
 
@@ -82,7 +417,7 @@ namespace Casimir {
              * @return A self-reference
              */
             inline LoggerChannelAdapter& operator<<(cuint value) {
-                m_msg.append(String::toString((cint) value));
+                if (m_storage) m_arguments.appendUnsigned(value);
                 return *this;
             }
 
@@ -92,7 +427,7 @@ namespace Casimir {
              * @return A self-reference
              */
             inline LoggerChannelAdapter& operator<<(cint value) {
-                m_msg.append(String::toString(value));
+                if (m_storage) m_arguments.appendInteger(value);
                 return *this;
             }
 
@@ -102,7 +437,7 @@ namespace Casimir {
              * @return A self-reference
              */
             inline LoggerChannelAdapter& operator<<(float value) {
-                m_msg.append(String::toString(value));
+                if (m_storage) m_arguments.appendFloat(value);
                 return *this;
             }
 
@@ -112,7 +447,7 @@ namespace Casimir {
              * @return A self-reference
              */
             inline LoggerChannelAdapter& operator<<(double value) {
-                m_msg.append(String::toString(value));
+                if (m_storage) m_arguments.appendDouble(value);
                 return *this;
             }
 
@@ -122,17 +457,18 @@ namespace Casimir {
              * @return A self-reference
              */
             inline LoggerChannelAdapter& operator<<(const void* ptr) {
-                m_msg.append(String((char*)&ptr, sizeof(void*)).encodeToHex());
+                if (m_storage) m_arguments.appendPointer(ptr);
                 return *this;
             }
 
             /**
              * @brief Append an StringSerializable object to the logging message
-             * @param stringSerializable the stringSerializable object (that will be convert to String)
+             * @param stringSerializable the stringSerializable object (converted to String right away since the
+             * object may change before the message is emitted)
              * @return A self-reference
              */
             inline LoggerChannelAdapter& operator<<(const StringSerializable& stringSerializable) {
-                m_msg.append(stringSerializable.toString());
+                if (m_storage) operator<<(stringSerializable.toString());
                 return *this;
             }
 
@@ -142,11 +478,49 @@ namespace Casimir {
              * @return A self-reference
              */
             inline LoggerChannelAdapter& operator<<(const char* msg) {
-                m_msg.append(msg);
+                if (m_storage) m_arguments.appendText(msg, (cuint) std::strlen(msg));
                 return *this;
             }
         };
 
+        /**
+         * @brief A channel of a Logger resolved once (see Logger::resolve). Logging through a LoggerChannelHandle
+         * doesn't perform any lookup, reference counting or allocation before the message itself
+         * @note The handle keeps the Logger alive
+         */
+        class LoggerChannelHandle {
+            friend class Logger;
+        private:
+            std::shared_ptr<__Logger> m_logger;
+            const __LoggerChannelStorage* m_storage;
+
+            /**
+             * @brief Private constructor of LoggerChannelHandle (see Logger::resolve)
+             * @param logger the Logger owning the channel
+             * @param storage the storage of the channel (nullptr if the channel doesn't exist)
+             */
+            inline LoggerChannelHandle(std::shared_ptr<__Logger> logger, const __LoggerChannelStorage* storage)
+                : m_logger(std::move(logger)), m_storage(storage) {}
+
+        public:
+            /**
+             * @brief Default constructor of a LoggerChannelHandle that doesn't refer to any channel (always disabled)
+             */
+            inline LoggerChannelHandle() : m_logger(nullptr), m_storage(nullptr) {}
+
+            /**
+             * @brief Whether or not the messages logged through the handle are handed to any logger channel
+             * @return false if the channel doesn't exist, has no logger channel or has been disabled
+             */
+            CASIMIR_EXPORT bool isEnabled() const;
+
+            /**
+             * @brief Retrieve the LoggerChannelAdapter of the channel
+             * @return The LoggerChannelAdapter that can be used to log directly into the channel
+             */
+            CASIMIR_EXPORT LoggerChannelAdapter operator()() const;
+        };
+
         /**
          * @brief The logger is a class that manager every channels and can instantiate a LoggerChannelAdapter from an Uuid
          * @note Once constructed the logging process is granted to be thread-safe
@@ -157,22 +531,23 @@ namespace Casimir {
         private:
             std::shared_ptr<__Logger> m_handle;
 
-            /**
-             * @brief Internal storage class that store a list of channels logger as long as a
-             * parsing function for each channel.
-             */
-            struct __LoggerChannelStorage {
-                std::vector<std::shared_ptr<AbstractLoggerChannel>> channels;
-                std::function<String(const String&)> parser;
-            };
-
             /**
              * @brief Private constructor of Logger
              * @param channels A map of all the channels by Uuid
+             * @param asyncCapacity The capacity of the asynchronous queue (0 for a synchronous Logger)
+             * @param overflowPolicy The behavior of the asynchronous queue when full
              */
-            CASIMIR_EXPORT explicit Logger(const std::unordered_map<Uuid, __LoggerChannelStorage>& channels);
+            CASIMIR_EXPORT explicit Logger(const std::unordered_map<Uuid, __LoggerChannelStorage>& channels,
+                                           cuint asyncCapacity, LoggerOverflowPolicy overflowPolicy);
 
         public:
+            /**
+             * @brief Resolve the channel registered under `uuid` once so that it can be logged into without any lookup
+             * @param uuid the Uuid under which the channel as been registered
+             * @return The LoggerChannelHandle of the channel (disabled if the channel doesn't exist)
+             */
+            CASIMIR_EXPORT LoggerChannelHandle resolve(const Uuid& uuid) const;
+
             /**
              * @brief Retrieve the LoggerChannelAdapter corresponding to the given Uuid
              * @param uuid the Uuid under which the channel as been registered
@@ -200,6 +575,41 @@ namespace Casimir {
             inline LoggerChannelAdapter operator[](const Uuid& uuid) const {
                 return at(uuid);
             }
+
+            /**
+             * @brief Whether or not the messages logged into the channel `uuid` are handed to any logger channel
+             * @param uuid the Uuid under which the channel as been registered
+             * @return false if the channel doesn't exist, has no logger channel or has been disabled
+             */
+            CASIMIR_EXPORT bool isEnabled(const Uuid& uuid) const;
+
+            /**
+             * @brief Enable or disable the channel `uuid`. A disabled channel skips the conversion of the streamed
+             * arguments and never reaches the logger channels
+             * @note The state is shared by every copy of the current Logger and can be changed from any thread
+             * @param uuid the Uuid under which the channel as been registered (ignored if unknown)
+             * @param enabled the new state of the channel
+             */
+            CASIMIR_EXPORT void setEnabled(const Uuid& uuid, bool enabled);
+
+            /**
+             * @brief Block until every message logged before this call has been handed to the logger channels.
+             * This is a no-op for a synchronous Logger
+             */
+            CASIMIR_EXPORT void flush() const;
+
+            /**
+             * @brief Return the number of messages discarded because the asynchronous queue was full
+             * @note Only counted with the LoggerOverflowPolicy::DropAndCount policy
+             * @return the number of discarded messages since the creation of the Logger
+             */
+            CASIMIR_EXPORT cuint droppedCount() const;
+
+            /**
+             * @brief Whether or not the messages are handed to a background thread
+             * @return true if the current Logger is asynchronous
+             */
+            CASIMIR_EXPORT bool isAsynchronous() const;
         };
 
         /**
@@ -207,7 +617,9 @@ namespace Casimir {
          */
         class LoggerBuilder {
         private:
-            std::unordered_map<Uuid, Logger::__LoggerChannelStorage> m_channels;
+            std::unordered_map<Uuid, __LoggerChannelStorage> m_channels;
+            cuint m_asyncCapacity = 0;
+            LoggerOverflowPolicy m_overflowPolicy = LoggerOverflowPolicy::Block;
 
         public:
             /**
@@ -220,6 +632,52 @@ namespace Casimir {
             CASIMIR_EXPORT LoggerBuilder& registerChannelAt(const Uuid& uuid, const std::shared_ptr<AbstractLoggerChannel>& channel,
                                                             const std::function<String(const String&)>& parser);
 
+            /**
+             * @brief Register a new channel in the future Logger whose parser displays the time of the messages
+             * @param uuid The new channel will be register under the uuid name
+             * @param channel A shared pointer to an instance of AbstractLoggerChannel
+             * @param parser The parsing object that enable to control the resulting message. It receives the time
+             * the message has been logged at (not the time it is emitted at in an asynchronous Logger)
+             * @return A self-reference
+             */
+            CASIMIR_EXPORT LoggerBuilder& registerChannelAt(
+                    const Uuid& uuid, const std::shared_ptr<AbstractLoggerChannel>& channel,
+                    const std::function<String(const String&, std::chrono::system_clock::time_point)>& parser);
+
+            /**
+             * @brief Make the future Logger asynchronous. The caller only pushes the message into a bounded lock-free
+             * queue and a single background thread performs the parsing and calls the logger channels
+             * @param capacity The number of messages the queue can hold (rounded up to a power of two). A capacity
+             * of 0 makes the Logger synchronous again
+             * @param overflowPolicy The behavior when the queue is full
+             * @note The logger channels are only called from the background thread, in the order the messages were
+             * pushed in the queue
+             * @return A self-reference
+             */
+            CASIMIR_EXPORT LoggerBuilder& setAsynchronous(cuint capacity,
+                                                          LoggerOverflowPolicy overflowPolicy = LoggerOverflowPolicy::Block);
+
+            /**
+             * @brief Limit the number of messages logged into the channel `uuid` with a token bucket. The messages
+             * above the limit are discarded before any formatting and a single record telling how many messages have
+             * been suppressed is logged once the channel is allowed again
+             * @param uuid The Uuid of a channel already registered
+             * @param messagesPerSecond The rate at which the bucket is refilled (0 removes the limit)
+             * @param burst The number of messages that can be logged at once (at least 1)
+             * @return A self-reference
+             */
+            CASIMIR_EXPORT LoggerBuilder& setRateLimit(const Uuid& uuid, cuint messagesPerSecond, cuint burst);
+
+            /**
+             * @brief Merge the identical consecutive messages logged into the channel `uuid`. Only the first one is
+             * logged, followed by a single "Last message repeated N times" record when a different message is
+             * logged, when the Logger is flushed or destroyed
+             * @param uuid The Uuid of a channel already registered
+             * @param enabled Whether or not the repeated messages are coalesced
+             * @return A self-reference
+             */
+            CASIMIR_EXPORT LoggerBuilder& setRepeatCoalescing(const Uuid& uuid, bool enabled = true);
+
             /**
              * @brief Create a new instance of logger based on the configuration above
              * @return The newly created instance of logger
@@ -228,12 +686,66 @@ namespace Casimir {
         };
 
         /**
-         * @brief Simple logger that log the resulting message to the terminal
+         * @brief Internal background thread that calls a flush function every interval until it is stopped (see
+         * ShellLogger and FileLogger)
+         */
+        class __PeriodicFlusher {
+            CASIMIR_DISABLE_COPY_MOVE(__PeriodicFlusher)
+        private:
+            std::mutex m_mutex;
+            std::condition_variable m_wakeUp;
+            bool m_stop;
+            std::thread m_thread;
+
+        public:
+            /**
+             * @brief Default constructor of a __PeriodicFlusher that is not started
+             */
+            inline __PeriodicFlusher() : m_stop(false) {}
+
+            /**
+             * @brief Start the background thread. A failing flush is reported on std::cerr and retried at the next
+             * interval
+             * @param interval the time between two calls of `flush`
+             * @param flush the function to be called
+             */
+            CASIMIR_EXPORT void start(std::chrono::milliseconds interval, std::function<void()> flush);
+
+            /**
+             * @brief Stop and join the background thread if it has been started. Once it returns, `flush` is not
+             * called anymore
+             */
+            CASIMIR_EXPORT void stop();
+
+            /**
+             * @brief Destructor of the __PeriodicFlusher that stops the background thread
+             */
+            inline ~__PeriodicFlusher() {
+                stop();
+            }
+        };
+
+        /**
+         * @brief Simple logger that log the resulting message to the terminal. By default the messages go through
+         * std::cout, the direct mode bypasses iostream and writes to the file descriptor of the stream
          */
         class ShellLogger : public AbstractLoggerChannel {
             CASIMIR_DISABLE_COPY_MOVE(ShellLogger)
         private:
             Mutex m_mutex;
+            int m_fd;
+            bool m_lineBuffered;
+            std::vector<char> m_buffer;
+            cuint m_bufferSize;
+            std::chrono::milliseconds m_flushInterval;
+            __PeriodicFlusher m_flusher;
+
+            /**
+             * @brief Write the whole buffer to the file descriptor. The buffer is emptied even if the write fails
+             * @note The caller must own m_mutex
+             * @throw Casimir::Exception if the file descriptor doesn't accept the whole buffer
+             */
+            void flushBuffer();
 
         public:
             /**
@@ -242,12 +754,44 @@ namespace Casimir {
              */
             CASIMIR_EXPORT explicit ShellLogger();
 
+            /**
+             * @brief Direct ShellLogger constructor. Messages are written to the file descriptor of `stream` with
+             * write(2) and the ones logged close together are coalesced into a single call
+             * @param stream the standard stream the messages are written to
+             * @param buffering when the buffered messages are written (Auto checks whether the stream is a terminal)
+             * @param bufferSize the size in bytes of the user-space buffer
+             * @param flushInterval the maximum time a message stays in the buffer when block buffered
+             * @note Do not mix with std::cout / std::cerr on the same stream, their buffers are not shared
+             */
+            CASIMIR_EXPORT explicit ShellLogger(ShellLoggerStream stream,
+                                                ShellLoggerBuffering buffering = ShellLoggerBuffering::Auto,
+                                                cuint bufferSize = 16 * 1024,
+                                                std::chrono::milliseconds flushInterval = std::chrono::milliseconds(100));
+
             /**
              * @brief Override the log from the AbstractLoggerChannel. Log a message to the screen.
              * @note This methods is granted to be thread-safe
              * @param msg the message to be logged
+             * @throw Casimir::Exception if the stream doesn't accept the messages written
              */
             CASIMIR_EXPORT void log(const String &msg) override;
+
+            /**
+             * @brief Write every buffered message to the stream
+             * @throw Casimir::Exception if the stream doesn't accept the buffered messages
+             */
+            CASIMIR_EXPORT void flush();
+
+            /**
+             * @brief Whether or not every complete line is written right away
+             * @return true if the ShellLogger is line buffered, false if it is block buffered or uses std::cout
+             */
+            CASIMIR_EXPORT bool isLineBuffered() const;
+
+            /**
+             * @brief ShellLogger destructor that flush the buffer
+             */
+            CASIMIR_EXPORT ~ShellLogger() override;
         };
 
         /**
@@ -258,25 +802,71 @@ namespace Casimir {
             CASIMIR_DISABLE_COPY_MOVE(FileLogger);
         private:
             Mutex m_mutex;
-            std::fstream* m_fstream;
+            int m_fd;
+            std::vector<char> m_buffer;
+            cuint m_bufferSize;
+            std::vector<Uuid> m_immediateChannels;
+            std::chrono::milliseconds m_flushInterval;
+            __PeriodicFlusher m_flusher;
+
+            /**
+             * @brief Append `msg` to the buffer (or write it directly) and flush if requested
+             * @param msg the message to be written
+             * @param immediate whether or not the buffer must be flushed after this message
+             */
+            void write(const String& msg, bool immediate);
+
+            /**
+             * @brief Write the whole buffer to the file descriptor. The buffer is emptied even if the write fails
+             * @note The caller must own m_mutex
+             * @throw Casimir::Exception if the file descriptor doesn't accept the whole buffer
+             */
+            void flushBuffer();
 
         public:
             /**
-             * @brief Default FileLogger constructor
+             * @brief Default FileLogger constructor. Every message is written to the file right away
              * @param filepath the file path where we want the output to be logged
              */
             CASIMIR_EXPORT explicit FileLogger(const String& filepath);
 
+            /**
+             * @brief Buffered FileLogger constructor. Messages are stored in a user-space buffer that is written to
+             * the file when full, every `flushInterval` or right after a message from one of the `immediateChannels`
+             * @param filepath the file path where we want the output to be logged
+             * @param bufferSize the size in bytes of the user-space buffer (0 disables the buffering)
+             * @param flushInterval the maximum time a message stays in the buffer (0 disables the periodic flush)
+             * @param immediateChannels the channels (such as PrivateLogging::Error) whose messages must be durable
+             * as soon as they are logged
+             */
+            CASIMIR_EXPORT FileLogger(const String& filepath, cuint bufferSize, std::chrono::milliseconds flushInterval,
+                                      std::vector<Uuid> immediateChannels = {});
+
             /**
              * @brief Log a given msg directly to a file (without any further parsing done)
              * @param msg the String we wanted to append into the log file
+             * @throw Casimir::Exception if the file doesn't accept the messages written
              */
             CASIMIR_EXPORT void log(const String &msg) override;
 
             /**
-             * @brief FileLogger destructor that close the log file.
+             * @brief Log a given msg and flush right away if `channel` is one of the immediate channels
+             * @param channel the Uuid of the channel the message has been logged into
+             * @param msg the String we wanted to append into the log file
+             * @throw Casimir::Exception if the file doesn't accept the messages written
+             */
+            CASIMIR_EXPORT void logFrom(const Uuid& channel, const String& msg) override;
+
+            /**
+             * @brief Write every buffered message to the file
+             * @throw Casimir::Exception if the file doesn't accept the buffered messages
+             */
+            CASIMIR_EXPORT void flush();
+
+            /**
+             * @brief FileLogger destructor that flush the buffer and close the log file.
              */
-            CASIMIR_EXPORT ~FileLogger();
+            CASIMIR_EXPORT ~FileLogger() override;
         };
 
 
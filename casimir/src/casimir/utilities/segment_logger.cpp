@@ -0,0 +1,308 @@
+#include "segment_logger.hpp"
+#include "exception.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <system_error>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+namespace Casimir {
+
+    using namespace literals;
+
+    /**
+     * @brief Check whether or not a file exists at `path`
+     */
+    static bool fileExists(const utilities::String& path) {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) return false;
+        fclose(file);
+        return true;
+    }
+
+    /**
+     * @brief Throw a SystemException describing the last error of the platform
+     */
+    [[noreturn]] static void throwSystemError(const utilities::String& what) {
+#ifdef _WIN32
+        const int error = (int) GetLastError();
+#else
+        const int error = errno;
+#endif
+        using utilities::Exception;
+        CASIMIR_THROW_EXCEPTION("SystemException", std::system_error(error, std::system_category(), what.str()).what());
+    }
+
+    /**
+     * @brief Number of producer slots of a SegmentLogger (power of two), one per hardware thread up to 64
+     */
+    static cuint producerSlotCount() {
+        const cuint threads = std::max<cuint>(std::thread::hardware_concurrency(), 1);
+        cuint count = 1;
+        while (count < threads && count < 64) count <<= 1U;
+        return count;
+    }
+
+    /**
+     * @brief Round-robin index given to each thread the first time it logs into a SegmentLogger
+     */
+    static cuint producerSlotIndex() {
+        static std::atomic<cuint> nextIndex(0);
+        static thread_local const cuint index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    CASIMIR_EXPORT utilities::SegmentLogger::SegmentLogger(const utilities::String& basePath, cuint segmentSize,
+                                                           cuint maxSegments)
+        : m_basePath(basePath), m_segmentSize(segmentSize), m_maxSegments(maxSegments), m_nextIndex(0),
+          m_current(nullptr), m_standby(nullptr), m_droppedCount(0), m_slotMask(producerSlotCount() - 1),
+          m_slots(new ProducerSlot[m_slotMask + 1]), m_epoch(0), m_stop(false) {
+        if (segmentSize == 0 || (maxSegments != 0 && maxSegments < 3)) {
+            CASIMIR_THROW_EXCEPTION("InvalidArgument", "A SegmentLogger requires a non-empty segment size and "
+                                                       "at least 3 segments when the number of segments is bounded");
+        }
+
+        m_current.store(createSegment());
+        m_standby.store(createSegment());
+        m_thread = std::thread(&SegmentLogger::run, this);
+    }
+
+    utilities::SegmentLogger::Segment* utilities::SegmentLogger::createSegment() {
+        // Never overwrite a segment of a previous session
+        String path;
+        do {
+            const String index = String::toString((cint) m_nextIndex++);
+            path = m_basePath + "." + String('0', toUnsigned(6 - (cint) index.length())) + index;
+        } while (fileExists(path));
+
+        std::unique_ptr<Segment> segment = std::make_unique<Segment>();
+        segment->path = path;
+        segment->capacity = m_segmentSize;
+#ifdef _WIN32
+        segment->file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                    CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (segment->file == INVALID_HANDLE_VALUE) throwSystemError("Cannot create segment " + path);
+        segment->mapping = CreateFileMappingA(segment->file, nullptr, PAGE_READWRITE,
+                                              (DWORD) ((uint64) m_segmentSize >> 32U),
+                                              (DWORD) ((uint64) m_segmentSize & 0xFFFFFFFFU), nullptr);
+        if (!segment->mapping) {
+            CloseHandle(segment->file);
+            throwSystemError("Cannot map segment " + path);
+        }
+        segment->data = (char*) MapViewOfFile(segment->mapping, FILE_MAP_WRITE, 0, 0, (SIZE_T) m_segmentSize);
+        if (!segment->data) {
+            CloseHandle(segment->mapping);
+            CloseHandle(segment->file);
+            throwSystemError("Cannot map segment " + path);
+        }
+#else
+        segment->fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (segment->fd < 0) throwSystemError("Cannot create segment " + path);
+
+        // Reserve the blocks right away so that writing into the mapping never has to allocate them
+#ifdef __linux__
+        const int allocationError = posix_fallocate(segment->fd, 0, (off_t) m_segmentSize);
+        if (allocationError != 0) errno = allocationError;
+#else
+        const int allocationError = ftruncate(segment->fd, (off_t) m_segmentSize);
+#endif
+        if (allocationError != 0) {
+            close(segment->fd);
+            throwSystemError("Cannot preallocate segment " + path);
+        }
+        void* data = mmap(nullptr, (size_t) m_segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+        if (data == MAP_FAILED) {
+            close(segment->fd);
+            throwSystemError("Cannot map segment " + path);
+        }
+        segment->data = (char*) data;
+#endif
+        m_segments.push_back(std::move(segment));
+        return m_segments.back().get();
+    }
+
+    void utilities::SegmentLogger::finalizeSegment(utilities::SegmentLogger::Segment& segment, cuint size) {
+#ifdef _WIN32
+        UnmapViewOfFile(segment.data);
+        CloseHandle(segment.mapping);
+        LARGE_INTEGER position;
+        position.QuadPart = (LONGLONG) size;
+        SetFilePointerEx(segment.file, position, nullptr, FILE_BEGIN);
+        SetEndOfFile(segment.file);
+        CloseHandle(segment.file);
+#else
+        munmap(segment.data, (size_t) segment.capacity);
+        if (ftruncate(segment.fd, (off_t) size) != 0) {
+            std::cerr << "Cannot truncate segment " << segment.path.c_str() << std::endl;
+        }
+        close(segment.fd);
+#endif
+        segment.data = nullptr;
+
+        // Segments that never received any message are useless
+        if (size == 0) {
+            std::remove(segment.path.c_str());
+            return;
+        }
+        m_finalizedPaths.push_back(segment.path);
+    }
+
+    bool utilities::SegmentLogger::rotate(utilities::SegmentLogger::Segment* segment) {
+        if (m_current.load() != segment) return true;
+
+        Segment* standby = m_standby.exchange(nullptr);
+        m_wakeUp.notify_one();
+        if (!standby) {
+            return m_current.load() != segment;
+        }
+
+        Segment* expected = segment;
+        if (!m_current.compare_exchange_strong(expected, standby)) {
+            // Another producer already rotated: give the standby segment back or let the background thread remove it
+            Segment* empty = nullptr;
+            if (!m_standby.compare_exchange_strong(empty, standby, std::memory_order_acq_rel)) {
+                standby->end.store(0, std::memory_order_release);
+            }
+        }
+        return true;
+    }
+
+    CASIMIR_EXPORT void utilities::SegmentLogger::log(const utilities::String& msg) {
+        const cuint length = msg.length();
+        if (length == 0) return;
+        if (length > m_segmentSize) {
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Either the background thread sees the announcement or this producer sees the segment that replaced the
+        // retired one (both sequentially consistent)
+        std::atomic<cuint>& producers = m_slots[producerSlotIndex() & m_slotMask].producers[m_epoch.load() & 1U];
+        producers.fetch_add(1);
+        write(msg);
+        producers.fetch_sub(1, std::memory_order_release);
+    }
+
+    void utilities::SegmentLogger::write(const utilities::String& msg) {
+        const cuint length = msg.length();
+        while (true) {
+            Segment* segment = m_current.load();
+            const cuint position = segment->reserved.fetch_add(length, std::memory_order_relaxed);
+            if (position + length <= segment->capacity) {
+                memcpy(segment->data + position, msg.c_str(), (size_t) length);
+                segment->committed.fetch_add(length, std::memory_order_release);
+                return;
+            }
+
+            // Exactly one producer crosses the end of the segment: it records the size actually written
+            if (position <= segment->capacity) {
+                segment->end.store(position, std::memory_order_release);
+            }
+            if (!rotate(segment)) {
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    void utilities::SegmentLogger::releaseSegments() {
+        // Only the background thread moves the epoch
+        while (!m_retired.empty() && m_epoch.load(std::memory_order_relaxed) - m_retired.front().first < 3) {
+            const cuint epoch = m_epoch.load(std::memory_order_relaxed);
+            for (cuint i = 0; i <= m_slotMask; ++i) {
+                if (m_slots[i].producers[(epoch + 1) & 1U].load() != 0) return;
+            }
+            m_epoch.store(epoch + 1);
+        }
+        const cuint epoch = m_epoch.load(std::memory_order_relaxed);
+        while (!m_retired.empty() && epoch - m_retired.front().first >= 3) m_retired.pop_front();
+    }
+
+    void utilities::SegmentLogger::run() {
+        Segment* prepared = nullptr;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stop) {
+            lock.unlock();
+
+            // Always keep a standby segment ready for the next rotation
+            if (!prepared && !m_standby.load(std::memory_order_acquire)) {
+                try {
+                    prepared = createSegment();
+                } catch (const Exception& exception) {
+                    std::cerr << exception.what() << std::endl;
+                }
+            }
+            if (prepared) {
+                Segment* empty = nullptr;
+                if (m_standby.compare_exchange_strong(empty, prepared, std::memory_order_acq_rel)) {
+                    prepared = nullptr;
+                }
+            }
+
+            // Finalize the full segments once every reserved message has been copied. They cannot become the current
+            // segment again, but a slow producer may still hold a pointer to them, hence they are only retired
+            const Segment* current = m_current.load();
+            const Segment* standby = m_standby.load();
+            for (auto it = m_segments.begin(); it != m_segments.end();) {
+                Segment* segment = it->get();
+                const cuint end = segment->end.load(std::memory_order_acquire);
+                if (segment == current || segment == standby || segment == prepared || end == String::notFound() ||
+                    segment->committed.load(std::memory_order_acquire) != end) {
+                    ++it;
+                    continue;
+                }
+                finalizeSegment(*segment, end);
+                m_retired.emplace_back(m_epoch.load(), std::move(*it));
+                it = m_segments.erase(it);
+            }
+            releaseSegments();
+
+            // Bound the disk usage (the current and the standby segments are always kept)
+            while (m_maxSegments != 0 && m_finalizedPaths.size() + 2 > m_maxSegments) {
+                std::remove(m_finalizedPaths.front().c_str());
+                m_finalizedPaths.pop_front();
+            }
+
+            lock.lock();
+            if (!m_stop) {
+                m_wakeUp.wait_for(lock, std::chrono::milliseconds(10));
+            }
+        }
+
+        if (prepared) prepared->end.store(0, std::memory_order_release);
+    }
+
+    CASIMIR_EXPORT cuint utilities::SegmentLogger::droppedCount() const {
+        return m_droppedCount.load(std::memory_order_relaxed);
+    }
+
+    CASIMIR_EXPORT utilities::SegmentLogger::~SegmentLogger() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_wakeUp.notify_one();
+        }
+        m_thread.join();
+
+        // No producer is left: every segment still mapped can be finalized with what has been written
+        for (const auto& segment : m_segments) {
+            if (segment->data) {
+                finalizeSegment(*segment, segment->committed.load(std::memory_order_acquire));
+            }
+        }
+    }
+
+}
@@ -0,0 +1,151 @@
+#ifndef CASIMIR_SEGMENT_LOGGER_HPP_
+#define CASIMIR_SEGMENT_LOGGER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <condition_variable>
+
+#include "../casimir.hpp"
+#include "string.hpp"
+#include "logger.hpp"
+
+namespace Casimir {
+
+    namespace utilities {
+
+        /**
+         * @brief Logger channel that copies the messages into memory-mapped segment files of a fixed size. Segments
+         * are named `<basePath>.<index>`, preallocated by a background thread and rotated when full. Producers only
+         * perform an atomic reservation and a copy: they never wait for the creation of a segment (a message that
+         * cannot be stored because the next segment isn't ready yet is dropped and counted)
+         * @note This class is thread-safe
+         */
+        class SegmentLogger : public AbstractLoggerChannel {
+            CASIMIR_DISABLE_COPY_MOVE(SegmentLogger);
+        private:
+            /**
+             * @brief A mapped segment file
+             */
+            struct Segment {
+                String path;
+                char* data = nullptr;
+                cuint capacity = 0;
+                std::atomic<cuint> reserved{0};
+                std::atomic<cuint> committed{0};
+                std::atomic<cuint> end{String::notFound()};
+#ifdef _WIN32
+                void* file = nullptr;
+                void* mapping = nullptr;
+#else
+                int fd = -1;
+#endif
+            };
+
+            struct alignas(64) ProducerSlot {
+                std::atomic<cuint> producers[2] = {}; // Producers in log() by parity of the epoch they announced
+            };
+
+            const String m_basePath;
+            const cuint m_segmentSize;
+            const cuint m_maxSegments;
+            cuint m_nextIndex;
+
+            std::atomic<Segment*> m_current;
+            std::atomic<Segment*> m_standby;
+            std::atomic<cuint> m_droppedCount;
+
+            // Only accessed by the background thread once constructed. A finalized segment is retired along with the
+            // epoch it has been retired in, and released once no producer can hold a pointer to it anymore
+            std::deque<std::unique_ptr<Segment>> m_segments;
+            std::deque<std::pair<cuint, std::unique_ptr<Segment>>> m_retired;
+            std::deque<String> m_finalizedPaths;
+
+            // A producer announces itself on the slot of its thread (one cache line per hardware thread)
+            const cuint m_slotMask;
+            std::unique_ptr<ProducerSlot[]> m_slots;
+            std::atomic<cuint> m_epoch;
+
+            std::mutex m_mutex;
+            std::condition_variable m_wakeUp;
+            bool m_stop;
+            std::thread m_thread;
+
+            /**
+             * @brief Create, preallocate and map the next segment file
+             * @throw Casimir::Exception if the segment cannot be created
+             * @return the newly created segment
+             */
+            Segment* createSegment();
+
+            /**
+             * @brief Unmap a segment and truncate the file to the size actually written
+             * @param segment the segment to be finalized
+             * @param size the number of bytes written into the segment
+             */
+            void finalizeSegment(Segment& segment, cuint size);
+
+            /**
+             * @brief Replace the full segment `segment` by the standby segment
+             * @param segment the full segment
+             * @return whether or not `segment` is no longer the current segment
+             */
+            bool rotate(Segment* segment);
+
+            /**
+             * @brief Copy the message into the current segment, rotating it when full (see log)
+             * @param msg the message to be copied
+             */
+            void write(const String& msg);
+
+            /**
+             * @brief Release the retired segments that no producer can reach anymore. A segment is released once the
+             * epoch moved three times since it has been retired, each move requiring the producers announced in the
+             * previous epoch to have left
+             */
+            void releaseSegments();
+
+            /**
+             * @brief Main loop of the background thread (preallocation, finalization and removal of segments)
+             */
+            void run();
+
+        public:
+            /**
+             * @brief Construct a SegmentLogger
+             * @param basePath the path prefix of the segment files
+             * @param segmentSize the size in bytes of each segment file
+             * @param maxSegments the maximum number of segment files kept on disk (0 for no limit, at least 3
+             * otherwise). The oldest segments are removed first
+             * @throw Casimir::Exception if the first segments cannot be created
+             */
+            CASIMIR_EXPORT SegmentLogger(const String& basePath, cuint segmentSize, cuint maxSegments = 0);
+
+            /**
+             * @brief Copy the message into the current segment
+             * @param msg the message to be logged
+             */
+            CASIMIR_EXPORT void log(const String& msg) override;
+
+            /**
+             * @brief Return the number of messages dropped because they were larger than a segment or because the
+             * next segment wasn't ready yet
+             * @return the number of dropped messages
+             */
+            CASIMIR_EXPORT cuint droppedCount() const;
+
+            /**
+             * @brief Destructor that finalizes the current segment and removes the unused standby segment
+             */
+            CASIMIR_EXPORT ~SegmentLogger() override;
+        };
+
+    }
+
+}
+
+#endif
@@ -1,28 +1,38 @@
 #include "string.hpp"
 #include "exception.hpp"
+#include "string_kernels.hpp"
+#include "string_builder.hpp"
+#include "string_replacer.hpp"
 
 #include <cstring>
 
 namespace Casimir {
 
-    CASIMIR_EXPORT cuint utilities::String::findFirstOf(const utilities::String& research, const cuint& afterPos) const {
+    CASIMIR_EXPORT char utilities::StringView::at(const cuint &pos) const {
+#ifdef CASIMIR_SAFE_CHECK
+        if(pos >= length()) {
+            CASIMIR_THROW_EXCEPTION("IndexOutOfRange", "Cannot find the given position as it"
+                                                       "doesn't correspond to any existing character");
+        }
+#endif
+        return m_data[pos];
+    }
+
+    CASIMIR_EXPORT cuint utilities::StringView::findFirstOf(const utilities::StringView& research,
+                                                            const cuint& afterPos) const {
         // If the length of the research is null then simply return `afterPos`
         if(research.length() == 0) return afterPos;
-        
-        // Loop over the m_str from `afterPos` until the current string sequence match the required characters
-        for (cuint i = afterPos; i < length(); ++i) {
-            // Check if the substring from `i` to `i + research.length()` match the research string
-            if(memcmp(c_str() + i, research.c_str(), research.length()) == 0) {
-                return i; // We have found the first occurrence
-            }
-        }
+        if(afterPos >= length()) return notFound();
 
-        // If the program reach this line this means that no occurrence of `research` has been detected in the string
-        return notFound();
+        // Only the characters from `afterPos` are searched (see kernels::findForward)
+        const cuint position = kernels::findForward(m_data + afterPos, length() - afterPos, research.data(),
+                                                    research.length());
+        return position == notFound() ? notFound() : afterPos + position;
     }
 
-    CASIMIR_EXPORT cuint utilities::String::findLastOf(const utilities::String& research, const cuint& beforePos) const {
-        // In the case were the String is empty
+    CASIMIR_EXPORT cuint utilities::StringView::findLastOf(const utilities::StringView& research,
+                                                           const cuint& beforePos) const {
+        // In the case were the view is empty
         if (length() == 0)
             return (research.length() == 0) ? (0) : (notFound());
 
@@ -33,19 +43,57 @@ namespace Casimir {
 #endif
         // If the length of the research is null then simply return `beforePos`
         if(research.length() == 0) return beforePos;
-        
-        // Loop over the m_str from `beforePos` until it reach 0
-        for (cuint i = beforePos + 1; i >= research.length(); --i) {
-            // Check if the substring from `i - research.length() + 1` to `i`
-            if(memcmp(c_str() + i - research.length(), research.c_str(), research.length()) == 0) {
-                return i - research.length();
-            }
+
+        // The occurrence must end at `beforePos` at the latest (see kernels::findBackward)
+        return kernels::findBackward(m_data, beforePos + 1, research.data(), research.length());
+    }
+
+    CASIMIR_EXPORT utilities::StringView utilities::StringView::substr(const cuint &start, const cuint &length) const {
+#ifdef CASIMIR_SAFE_CHECK
+        if(start > this->length() || length > this->length() - start) {
+            CASIMIR_THROW_EXCEPTION("IndexOutOfRange", "Cannot perform the given operation"
+                                                       "as the specified region isn't fully contained by the view");
         }
-        
-        // If the program reach this line this means that no occurrence of `research` has been detected in the string
-        return notFound();
+#endif
+        return StringView(m_data + start, length);
     }
-    
+
+    CASIMIR_EXPORT cuint utilities::StringView::findFirstNotHex() const {
+        return kernels::findFirstNotHex(m_data, length());
+    }
+
+    CASIMIR_EXPORT bool utilities::StringView::isAscii() const {
+        return kernels::isAscii(m_data, length());
+    }
+
+    CASIMIR_EXPORT cuint utilities::StringView::count(char value) const {
+        return kernels::countByte(m_data, length(), value);
+    }
+
+    CASIMIR_EXPORT utilities::String utilities::StringView::toString() const {
+        return String(*this);
+    }
+
+    CASIMIR_EXPORT bool utilities::StringSplitter::next(utilities::StringView& token) {
+        // An empty view holds a single (empty) token
+        if (m_text.length() == 0) {
+            if (m_position > 0 || m_discardEmptyStrings) return false;
+            m_position = 1;
+            token = m_text;
+            return true;
+        }
+
+        while (m_position < m_text.length()) {
+            // The token ends at the next separator (or at the end of the view)
+            const cuint nextPosition = m_separator.length() == 0 ? m_text.length() :
+                                       std::min(m_text.findFirstOf(m_separator, m_position), m_text.length());
+            token = StringView(m_text.data() + m_position, nextPosition - m_position);
+            m_position = nextPosition == m_text.length() ? nextPosition : nextPosition + m_separator.length();
+            if (token.length() != 0 || !m_discardEmptyStrings) return true;
+        }
+        return false;
+    }
+
     CASIMIR_EXPORT utilities::String utilities::String::substr(const cuint &start, const cuint &length) const {
 #ifdef CASIMIR_SAFE_CHECK
       if(start + length > this->length()) {
@@ -76,139 +124,101 @@ namespace Casimir {
         return m_str.at(pos);
     }
     
-    CASIMIR_EXPORT std::vector<utilities::String> utilities::String::split(const utilities::String& separator, bool discardEmptyStrings) const {
-        // Create the list that will contains the output vector
-        std::vector<String> sbStr;
-        
+    CASIMIR_EXPORT std::vector<utilities::String> utilities::String::split(const utilities::StringView& separator, bool discardEmptyStrings) const {
         // If the length is null
         if(length() == 0) return {""};
-        
-        // The current position that has been processed
-        cuint sPosition = 0;
-        while (sPosition < length()) {
-            // Compute the next position
-            cuint nextPosition = std::min(findFirstOf(separator, sPosition), length());
-            String nStr = substr(sPosition, nextPosition - sPosition);
-            if (nStr.length() != 0 || !discardEmptyStrings) {
-                sbStr.push_back(nStr);
-            }
-
-            // Increment the sPosition
-            sPosition = nextPosition + separator.length();
+
+        // Only the kept tokens are copied
+        std::vector<String> sbStr;
+        for (const StringView& token : StringView(*this).split(separator, discardEmptyStrings)) {
+            sbStr.emplace_back(token);
         }
-        
-        // Return the resulting buffer
         return sbStr;
     }
-    
-    CASIMIR_EXPORT bool utilities::String::startsWith(const utilities::String &str) const {
-        if(str.length() > length()) return false;
-        for (cuint i = 0; i < str.length(); ++i) {
-            if(str.at(i) != at(i))
-                return false;
-        }
-        return true;
-    }
-    
-    CASIMIR_EXPORT bool utilities::String::endsWith(const utilities::String &str) const {
-        if(str.length() > length()) return false;
-        for(cint i = length() - 1; i >= (cint) length() - str.length(); --i) {
-            if(at(i) != str.at(i - length() + str.length()))
-                return false;
+
+    CASIMIR_EXPORT utilities::String utilities::String::replaceAll(const utilities::StringView &str,
+                                                                   const utilities::StringView &replacement) const {
+        if (str.length() == 0) return *this;
+
+        // Copy the text between the occurrences straight into the result
+        String output;
+        output.reserve(length());
+        const StringView text(*this);
+        cuint position = 0;
+        for (cuint next = text.findFirstOf(str, 0); next != notFound(); next = text.findFirstOf(str, position)) {
+            output.append(c_str() + position, next - position);
+            output.append(replacement);
+            position = next + str.length();
         }
-        return true;
+        output.append(c_str() + position, length() - position);
+        return output;
     }
     
-    CASIMIR_EXPORT utilities::String utilities::String::replaceAll(const utilities::String &str,
-                                                                   const utilities::String &replacement) const {
-        return replacement.join(split(str, false), false);
+    CASIMIR_EXPORT utilities::String utilities::String::replaceAll(
+            const std::vector<std::pair<utilities::StringView, utilities::StringView>>& replacements) const {
+        return StringReplacer(replacements).apply(*this);
     }
-    
-    CASIMIR_EXPORT utilities::String utilities::String::join(std::vector<String> list, bool discardEmptyString) const {
-        String output;
+
+    CASIMIR_EXPORT utilities::String utilities::String::join(const std::vector<String>& list, bool discardEmptyString) const {
+        // The separator precedes every String but the first one and the discarded empty ones
+        const auto separated = [&](cuint i) { return i != 0 && (list[i].length() != 0 || !discardEmptyString); };
+        cuint totalLength = 0;
         for (cuint i = 0; i < list.size(); ++i) {
-            if(i == 0 || (list[i] == "" && discardEmptyString)) {
-                output += list[i];
-            }
-            else {
-                output += literals::operator+((*this), list[i]);
-            }
+            totalLength += list[i].length() + (separated(i) ? length() : 0);
         }
-        return output;
+
+        StringBuilder output(totalLength);
+        for (cuint i = 0; i < list.size(); ++i) {
+            if (separated(i)) output.append(*this);
+            output.append(list[i]);
+        }
+        return output.build();
     }
 
     CASIMIR_EXPORT utilities::String utilities::String::encodeToHex() const {
-        // Tools only used in this function that represent the hexadecimal alphabet
-        static constexpr char hexAlphabet[] = {
-                0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66
-        };
-
-        // Loop other each character of the string and replace each of the char by the hex correspondence
         // We already know the output length to be twice of the input length
-        String output('\0', 2 * length());
-        for(cuint i = 0; i < length(); ++i) {
-            // Retrieve the character at position `i`
-            const char value = at(i);
-
-            // Convert the string to hexadecimal
-            output[2 * i] = hexAlphabet[((value >> 4) & 0x0F)];
-            output[2 * i + 1] = hexAlphabet[(value & 0x0F)];
-        }
-
-        // Return the resulting String
-        return output;
+        std::string output(2 * length(), '\0');
+        kernels::encodeHex(c_str(), length(), &output[0]);
+        return String(std::move(output));
     }
 
     CASIMIR_EXPORT utilities::String utilities::String::decodeFromHex() const {
-        // We already know that the result will be half of the size of the current string
-        if(length() % 2 != 0) {
-            return String(); // The string isn't a valid string
-        }
+        cuint invalidPosition;
+        return decodeFromHex(invalidPosition);
+    }
 
-        // Otherwise allocate the result
-        String result('\0', length() / 2);
-
-        // Loop other each character of the resulting String
-        for(cuint i = 0; i < length() / 2; ++i) {
-            // Process separately v0 and v1
-            const char _v0 = at(2 * i);
-            char v0;
-            if(_v0 >= 'a' && _v0 <= 'f') v0 = _v0 - 'a' + 10;
-            else if(_v0 >= 'A' && _v0 <= 'F') v0 = _v0 - 'A' + 10;
-            else if(_v0 >= '0' && _v0 <= '9') v0 = _v0 - '0';
-            else return String(); // The current character isn't a valid hexadecimal character
-
-            const char _v1 = at(2 * i + 1);
-            char v1;
-            if(_v1 >= 'a' && _v1 <= 'f') v1 = _v1 - 'a' + 10;
-            else if(_v1 >= 'A' && _v1 <= 'F') v1 = _v1 - 'A' + 10;
-            else if(_v1 >= '0' && _v1 <= '9') v1 = _v1 - '0';
-            else return String(); // The current character isn't a valid hexadecimal character
-
-            // Simply set the resulting byte
-            result[i] = v0 << 4 | v1;
+    CASIMIR_EXPORT utilities::String utilities::String::decodeFromHex(cuint& invalidPosition) const {
+        // The last character of an odd-length string has no pair, the string is only validated (nothing is decoded)
+        if (length() % 2 != 0) {
+            invalidPosition = kernels::findFirstNotHex(c_str(), length() - 1);
+            if (invalidPosition == notFound()) invalidPosition = length() - 1;
+            return String();
         }
 
-        // Simply return the result
-        return result;
+        // We already know that the result will be half of the size of the current string
+        std::string result(length() / 2, '\0');
+        invalidPosition = kernels::decodeHex(c_str(), length(), &result[0]);
+        return invalidPosition == notFound() ? String(std::move(result)) : String();
     }
 
     CASIMIR_EXPORT utilities::String utilities::String::toUpperCase() const {
-        String result(*this);
-        for(cuint i = 0; i < length(); ++i) {
-            char& value = result[i];
-            if(value >= 'a' && value <= 'z') value -= 0x20;
-        }
-        return result;
+        std::string result(length(), '\0');
+        kernels::convertCase(c_str(), length(), &result[0], true);
+        return String(std::move(result));
     }
 
     CASIMIR_EXPORT utilities::String utilities::String::toLowerCase() const {
-        String result(*this);
-        for(cuint i = 0; i < length(); ++i) {
-            char& value = result[i];
-            if(value >= 'A' && value <= 'Z') value += 0x20;
-        }
-        return result;
+        std::string result(length(), '\0');
+        kernels::convertCase(c_str(), length(), &result[0], false);
+        return String(std::move(result));
+    }
+
+    CASIMIR_EXPORT void utilities::String::makeUpperCase() {
+        kernels::convertCase(m_str.data(), length(), &m_str[0], true);
+    }
+
+    CASIMIR_EXPORT void utilities::String::makeLowerCase() {
+        kernels::convertCase(m_str.data(), length(), &m_str[0], false);
     }
 
     CASIMIR_EXPORT void utilities::String::insert(const cuint &pos, const utilities::String &str) {
@@ -223,7 +233,12 @@ namespace Casimir {
     }
 
     CASIMIR_EXPORT utilities::String literals::operator+(const utilities::String& a, const utilities::String& b) {
-        return utilities::String(a.str() + b.str());
+        return utilities::StringBuilder::concat(a, b);
+    }
+
+    CASIMIR_EXPORT utilities::String literals::operator+(utilities::String&& a, const utilities::String& b) {
+        a.append(b);
+        return std::move(a);
     }
     
     
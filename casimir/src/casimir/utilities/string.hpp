@@ -9,6 +9,7 @@
 
 #include "../casimir.hpp"
 #include "string_serializable.hpp"
+#include "string_view.hpp"
 
 namespace Casimir {
 
@@ -69,6 +70,14 @@ namespace Casimir {
                 : String(serializable.toString())
             {}
 
+            /**
+             * @brief Construct a string by copying the characters of a utilities::StringView
+             * @param view the view whose characters are copied
+             */
+            inline explicit String(const StringView& view)
+                : m_str(view.data(), (size_t) view.length())
+            {}
+
             /**
              * @brief Convert a value to a String
              * @param value the `value` to be converted to a utilities::String
@@ -138,6 +147,31 @@ namespace Casimir {
                 m_str.append(count, value);
             }
 
+            /**
+             * @brief Append `size` bytes of `data` at the end of the current string
+             * @param data the bytes to be appended (may contain null bytes)
+             * @param size the number of bytes to be appended
+             */
+            inline void append(const char* data, cuint size) {
+                m_str.append(data, (size_t) size);
+            }
+
+            /**
+             * @brief Append the characters of a utilities::StringView at the end of the current string
+             * @param view the view whose characters are appended
+             */
+            inline void append(const StringView& view) {
+                m_str.append(view.data(), (size_t) view.length());
+            }
+
+            /**
+             * @brief Reserve enough memory so that the String can grow up to `capacity` bytes without reallocation
+             * @param capacity the number of bytes to be reserved
+             */
+            inline void reserve(cuint capacity) {
+                m_str.reserve((size_t) capacity);
+            }
+
             /**
              * @brief Get the length of the current String
              * @return  the length of the current String
@@ -162,6 +196,14 @@ namespace Casimir {
                 return m_str.c_str();
             }
 
+            /**
+             * @brief View the whole String without copying it
+             * @return A view that is safe to use as long as the current instance is alive and unmodified
+             */
+            inline operator StringView() const {
+                return StringView(m_str.data(), (cuint) m_str.length());
+            }
+
             /**
              * @brief Equality operator between two utilities::String
              * @param str The second String we are comparing to
@@ -204,7 +246,9 @@ namespace Casimir {
              * @return The position of the characters before the first occurrence of `research` after the afterPos. If
              * no occurrence is found return the <code>String::notFound()</code> constant
              */
-            CASIMIR_EXPORT cuint findFirstOf(const String& research, const cuint& afterPos) const;
+            inline cuint findFirstOf(const StringView& research, const cuint& afterPos) const {
+                return StringView(*this).findFirstOf(research, afterPos);
+            }
 
             /**
              * @brief Find the last occurrences of the research utilities::String before the position `beforePos`
@@ -213,7 +257,9 @@ namespace Casimir {
              * @return The position of the characters before the last occurrence of `research` before the beforePos. If
              * no occurrence is found return the <code>String::notFound()</code> constant
              */
-            CASIMIR_EXPORT cuint findLastOf(const String& research, const cuint& beforePos) const;
+            inline cuint findLastOf(const StringView& research, const cuint& beforePos) const {
+                return StringView(*this).findLastOf(research, beforePos);
+            }
 
             /**
              * @brief Find first occurrence of research
@@ -221,7 +267,7 @@ namespace Casimir {
              * @return The position of the characters before the first occurrence of `research`. If
              * no occurrence is found return the <code>String::notFound()</code> constant
              */
-            inline cuint findFirstOf(const String& research) const {
+            inline cuint findFirstOf(const StringView& research) const {
                 return findFirstOf(research,0);
             }
 
@@ -231,16 +277,43 @@ namespace Casimir {
              * @return The position of the characters before the last occurrence of `research`. If
              * no occurrence is found return the <code>String::notFound()</code> constant
              */
-            inline cuint findLastOf(const String& research) {
+            inline cuint findLastOf(const StringView& research) const {
                 return findLastOf(research, length() - 1);
             }
 
+            /**
+             * @brief Find the first character that isn't an hexadecimal digit (either case)
+             * @return The position of the first non-hexadecimal character. If all the characters are hexadecimal
+             * digits return the <code>String::notFound()</code> constant
+             */
+            inline cuint findFirstNotHex() const {
+                return StringView(*this).findFirstNotHex();
+            }
+
+            /**
+             * @brief Return whether or not all the characters are ASCII characters (below 0x80)
+             * @return the result of the above check
+             */
+            inline bool isAscii() const {
+                return StringView(*this).isAscii();
+            }
+
+            /**
+             * @brief Count the occurrences of the character `value`
+             * @param value the character to be counted
+             * @return The number of occurrences of `value`
+             */
+            inline cuint count(char value) const {
+                return StringView(*this).count(value);
+            }
+
             /**
              * @brief Extract the sub-string that start at position `start` and has length `length`
              * @param start the starting position of the sub-string we are considering
              * @param length the length of the sub-string we are considering
              * @throw utilities::Exception if the sub-string isn't contained in the current string
              * @return the resulting sub-string
+             * @note Use <code>StringView::substr</code> to get the sub-string without copying it
              */
             CASIMIR_EXPORT String substr(const cuint& start, const cuint& length) const;
 
@@ -282,30 +355,35 @@ namespace Casimir {
              * @param discardEmptyStrings Defines the behavior of the empty string. If an empty string is detected and
              * this argument is set to true then the empty string will be ignored
              * @return An std::vector<utilities::String> of the split string
+             * @note Use <code>StringView::split</code> to iterate over the tokens without copying them
              */
-            CASIMIR_EXPORT std::vector<String> split(const String& separator, bool discardEmptyStrings = false) const;
+            CASIMIR_EXPORT std::vector<String> split(const StringView& separator, bool discardEmptyStrings = false) const;
 
             /**
              * @brief Check if the string start with the given `str`
              * @param str the `str` to use for the check
              * @return Whether or not the string start with the given sequence
              */
-            CASIMIR_EXPORT bool startsWith(const String& str) const;
+            inline bool startsWith(const StringView& str) const {
+                return StringView(*this).startsWith(str);
+            }
 
             /**
              * @brief Check if the string end with the given `str`
              * @param str the `str` to use for the check
              * @return Whether or not the string end with the given sequence
              */
-            CASIMIR_EXPORT bool endsWith(const String& str) const;
+            inline bool endsWith(const StringView& str) const {
+                return StringView(*this).endsWith(str);
+            }
 
             /**
              * @brief Join a vector of String using the current instance as a separator
              * @param list the list of string to be join using the current instance as separator
              * @param discardEmptyString Whether or not empty string are discarded
-             * @return The resulting join string
+             * @return The resulting join string (built with a single allocation, see StringBuilder)
              */
-            CASIMIR_EXPORT String join(std::vector<String> list, bool discardEmptyString = true) const;
+            CASIMIR_EXPORT String join(const std::vector<String>& list, bool discardEmptyString = true) const;
 
             /**
              * @brief Join a list of argument convertible to String to a unique string using current instance as
@@ -331,7 +409,14 @@ namespace Casimir {
              * @param replacement The replacement String
              * @return The resulting String
              */
-            CASIMIR_EXPORT String replaceAll(const String& str, const String& replacement) const;
+            CASIMIR_EXPORT String replaceAll(const StringView& str, const StringView& replacement) const;
+
+            /**
+             * @brief Replace all occurrence of several patterns at once, in a single pass (see StringReplacer)
+             * @param replacements pairs (pattern, replacement), the longest pattern wins where several occur
+             * @return The resulting String
+             */
+            CASIMIR_EXPORT String replaceAll(const std::vector<std::pair<StringView, StringView>>& replacements) const;
 
             /**
              * @brief Convert the current String instance to hexadecimal
@@ -347,6 +432,14 @@ namespace Casimir {
              */
             CASIMIR_EXPORT String decodeFromHex() const;
 
+            /**
+             * @brief Convert the current String instance from hexadecimal back to the origin format
+             * @param invalidPosition set to the position of the first character that isn't an hexadecimal digit (the
+             * last one if the length is odd), or to <code>String::notFound()</code> if the String is valid
+             * @return The resulting decoding String if valid (otherwise return empty string)
+             */
+            CASIMIR_EXPORT String decodeFromHex(cuint& invalidPosition) const;
+
             /**
              * @brief Return a copy of this string where each character (standard in ASCII) is replace by a uppercase
              * version of itself if defined
@@ -361,6 +454,18 @@ namespace Casimir {
              */
             CASIMIR_EXPORT String toLowerCase() const;
 
+            /**
+             * @brief Replace each character (standard in ASCII) of this string by an uppercase version of itself if
+             * defined, without copying the string
+             */
+            CASIMIR_EXPORT void makeUpperCase();
+
+            /**
+             * @brief Replace each character (standard in ASCII) of this string by a lowercase version of itself if
+             * defined, without copying the string
+             */
+            CASIMIR_EXPORT void makeLowerCase();
+
             /**
              * @brief Insert a `str` to a given position in the string
              * @param pos the position where the string is inserted
@@ -388,6 +493,15 @@ namespace Casimir {
          */
         CASIMIR_EXPORT utilities::String operator+(const utilities::String& a, const utilities::String& b);
 
+        /**
+         * @brief Concatenate two String `a` and `b`, reusing the memory of the temporary `a` (so that a chain of
+         * concatenations appends to a single String)
+         * @param a the first String to be concatenate (moved into the result)
+         * @param b the second String to be concatenate
+         * @return the resulting String consisting of `a` followed by `b`
+         */
+        CASIMIR_EXPORT utilities::String operator+(utilities::String&& a, const utilities::String& b);
+
 #ifdef CASIMIR_LITERAL_OPERATOR
         /**
          * @brief Instantiate String using a literal separator
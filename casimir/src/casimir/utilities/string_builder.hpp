@@ -0,0 +1,135 @@
+#ifndef CASIMIR_STRING_BUILDER_HPP_
+#define CASIMIR_STRING_BUILDER_HPP_
+
+#include <utility>
+
+#include "../casimir.hpp"
+#include "string.hpp"
+#include "string_view.hpp"
+
+namespace Casimir {
+
+    namespace utilities {
+
+        /**
+         * @brief Build a String by appending parts in place. When the size of the result is known (or computed by
+         * StringBuilder::concat / StringBuilder::appendAll) the memory is reserved once, so that building a message
+         * out of many parts is linear and performs a single allocation
+         * @code
+         * String message = StringBuilder::concat("[", file, " @ ", String::toString((cint) line), "]: ", cause);
+         * @endcode
+         */
+        class StringBuilder {
+        private:
+            String m_str;
+
+        public:
+            /**
+             * @brief Create an empty builder
+             */
+            inline StringBuilder() = default;
+
+            /**
+             * @brief Create an empty builder able to hold `capacity` bytes without reallocation
+             * @param capacity the number of bytes to be reserved
+             */
+            inline explicit StringBuilder(cuint capacity) {
+                m_str.reserve(capacity);
+            }
+
+            /**
+             * @brief Concatenate all the `parts` into a new String, the memory is reserved once for the whole result
+             * @tparam Parts the types of the parts (convertible to StringView: String, C-String, std::string, ...)
+             * @param parts the parts to be concatenated
+             * @return the resulting String
+             */
+            template<typename... Parts>
+            static String concat(const Parts&... parts) {
+                StringBuilder builder;
+                builder.appendAll(parts...);
+                return builder.build();
+            }
+
+            /**
+             * @brief Reserve enough memory so that the built String can grow up to `capacity` bytes without
+             * reallocation
+             * @param capacity the number of bytes to be reserved
+             * @return the current builder
+             */
+            inline StringBuilder& reserve(cuint capacity) {
+                m_str.reserve(capacity);
+                return *this;
+            }
+
+            /**
+             * @brief Append the characters of `str`
+             * @param str the characters to be appended
+             * @return the current builder
+             */
+            inline StringBuilder& append(const StringView& str) {
+                m_str.append(str);
+                return *this;
+            }
+
+            /**
+             * @brief Append a single character
+             * @param value the character to be appended
+             * @return the current builder
+             */
+            inline StringBuilder& append(char value) {
+                m_str.append(1, value);
+                return *this;
+            }
+
+            /**
+             * @brief Append a single value multiple times
+             * @param count the number of times the value is added
+             * @param value the value to be appended
+             * @return the current builder
+             */
+            inline StringBuilder& append(cuint count, char value) {
+                m_str.append(count, value);
+                return *this;
+            }
+
+            /**
+             * @brief Append all the `parts`, reserving the memory they require beforehand
+             * @tparam Parts the types of the parts (convertible to StringView: String, C-String, std::string, ...)
+             * @param parts the parts to be appended
+             * @return the current builder
+             */
+            template<typename... Parts>
+            StringBuilder& appendAll(const Parts&... parts) {
+                // The parts are only measured once (a C-String would otherwise be measured twice)
+                const StringView views[] = {StringView(), StringView(parts)...};
+                cuint length = m_str.length();
+                for (const StringView& view : views) length += view.length();
+                m_str.reserve(length);
+                for (const StringView& view : views) m_str.append(view);
+                return *this;
+            }
+
+            /**
+             * @brief Get the length of the String built so far
+             * @return the current length
+             */
+            inline cuint length() const {
+                return m_str.length();
+            }
+
+            /**
+             * @brief Move the built String out of the builder (which is left empty)
+             * @return the built String
+             */
+            inline String build() {
+                String result(std::move(m_str));
+                m_str = String();
+                return result;
+            }
+        };
+
+    }
+
+}
+
+#endif
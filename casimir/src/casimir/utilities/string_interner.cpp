@@ -0,0 +1,65 @@
+#include "string_interner.hpp"
+
+namespace Casimir {
+
+    using namespace literals;
+
+    CASIMIR_EXPORT utilities::StringInterner::StringInterner() = default;
+
+    const utilities::__InternedStringEntry* utilities::StringInterner::lookup(const utilities::StringView& str) const {
+        auto it = m_index.find(str);
+        return it == m_index.end() ? nullptr : it->second;
+    }
+
+    CASIMIR_EXPORT utilities::InternedString utilities::StringInterner::intern(const utilities::StringView& str) {
+        if (str.isEmpty()) return InternedString();
+
+        // Most of the Strings are already interned
+        m_mutex.acquireSharedLock();
+        const __InternedStringEntry* entry = lookup(str);
+        m_mutex.releaseSharedLock();
+        if (entry != nullptr) return InternedString(entry);
+
+        // Another thread may have interned the String in the meantime
+        m_mutex.acquireLock();
+        entry = lookup(str);
+        if (entry == nullptr) {
+            try {
+                m_entries.push_back({String(str), (cuint) m_entries.size() + 1, (uint64) ViewHash()(str)});
+                entry = &m_entries.back();
+                m_index.emplace(StringView(entry->value), entry);
+            } catch (...) {
+                m_mutex.releaseLock();
+                throw;
+            }
+        }
+        m_mutex.releaseLock();
+        return InternedString(entry);
+    }
+
+    CASIMIR_EXPORT bool utilities::StringInterner::find(const utilities::StringView& str,
+                                                        utilities::InternedString& result) const {
+        if (str.isEmpty()) {
+            result = InternedString();
+            return true;
+        }
+        m_mutex.acquireSharedLock();
+        const __InternedStringEntry* entry = lookup(str);
+        m_mutex.releaseSharedLock();
+        if (entry != nullptr) result = InternedString(entry);
+        return entry != nullptr;
+    }
+
+    CASIMIR_EXPORT cuint utilities::StringInterner::size() const {
+        m_mutex.acquireSharedLock();
+        const cuint size = m_entries.size();
+        m_mutex.releaseSharedLock();
+        return size;
+    }
+
+    CASIMIR_EXPORT utilities::StringInterner& utilities::StringInterner::global() {
+        static StringInterner* interner = new StringInterner();
+        return *interner;
+    }
+
+}
@@ -0,0 +1,185 @@
+#ifndef CASIMIR_STRING_INTERNER_HPP_
+#define CASIMIR_STRING_INTERNER_HPP_
+
+#include <deque>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+#include "../casimir.hpp"
+#include "cmutex.hpp"
+#include "string.hpp"
+#include "string_view.hpp"
+
+namespace Casimir {
+
+    namespace utilities {
+
+        /**
+         * @brief Internal storage of a String interned by a StringInterner (never moved nor modified once created)
+         */
+        struct __InternedStringEntry {
+            const String value;
+            const cuint id;
+            const uint64 hash;
+        };
+
+        /**
+         * @brief Handle of a String interned by a StringInterner. The handle is a single pointer to the unique copy
+         * of the String held by the interner: it is copied, compared and hashed in constant time
+         * @warning Two handles are only comparable if they come from the same StringInterner, and a handle must not
+         * outlive its StringInterner
+         */
+        class InternedString {
+            friend class StringInterner;
+        private:
+            const __InternedStringEntry* m_entry = nullptr;
+
+            inline explicit InternedString(const __InternedStringEntry* entry)
+                : m_entry(entry)
+            {}
+
+        public:
+            /**
+             * @brief Create a handle of the empty string (the empty string is the same for every StringInterner)
+             */
+            inline InternedString() = default;
+
+            /**
+             * @brief Return the interned String
+             * @return A reference to the unique copy of the String held by the StringInterner
+             */
+            inline const String& str() const {
+                static const String empty;
+                return m_entry == nullptr ? empty : m_entry->value;
+            }
+
+            /**
+             * @brief View the interned String
+             * @return A view that is valid as long as the StringInterner is alive
+             */
+            inline StringView view() const {
+                return StringView(str());
+            }
+
+            /**
+             * @brief Return the identifier of the interned String. The identifiers of a StringInterner are given in
+             * the order of interning, starting at 1 (0 is the empty string)
+             * @return the identifier of the interned String
+             */
+            inline cuint id() const {
+                return m_entry == nullptr ? 0 : m_entry->id;
+            }
+
+            /**
+             * @brief Return the hash of the interned String (computed once by the StringInterner)
+             * @return the hash of the interned String
+             */
+            inline uint64 hash() const {
+                return m_entry == nullptr ? 0 : m_entry->hash;
+            }
+
+            /**
+             * @brief Return whether or not the interned String is the empty string
+             * @return Whether or not the handle is the one of the empty string
+             */
+            inline bool isEmpty() const {
+                return m_entry == nullptr;
+            }
+
+            /**
+             * @brief Equality operator between two handles of the same StringInterner
+             * @param other The second handle we are comparing to
+             * @return Whether or not the two handles refer to the same String
+             */
+            inline bool operator==(const InternedString& other) const {
+                return m_entry == other.m_entry;
+            }
+
+            /**
+             * @brief Non-equality operator between two handles of the same StringInterner
+             * @param other The second handle we are comparing to
+             * @return Whether or not the two handles refer to different Strings
+             */
+            inline bool operator!=(const InternedString& other) const {
+                return m_entry != other.m_entry;
+            }
+        };
+
+        /**
+         * @brief Thread-safe table keeping a single copy of each String it is given, so that names repeated all over
+         * the library (channel names, lock names, ...) are only stored once and are handled through InternedString
+         * @note The lookups of already interned Strings run in parallel (see SharedMutex), only the first interning of
+         * a String takes the lock in exclusive mode. The interned Strings are released with the StringInterner
+         */
+        class StringInterner {
+            CASIMIR_DISABLE_COPY_MOVE(StringInterner);
+        private:
+            struct ViewHash {
+                inline std::size_t operator()(const StringView& view) const {
+                    return std::hash<std::string_view>()(std::string_view(view.data(), (size_t) view.length()));
+                }
+            };
+
+            mutable SharedMutex m_mutex;
+            std::deque<__InternedStringEntry> m_entries;
+            std::unordered_map<StringView, const __InternedStringEntry*, ViewHash> m_index;
+
+            /**
+             * @brief Return the entry of `str`, nullptr if it hasn't been interned (requires the lock)
+             */
+            const __InternedStringEntry* lookup(const StringView& str) const;
+
+        public:
+            /**
+             * @brief Create an empty StringInterner
+             */
+            CASIMIR_EXPORT StringInterner();
+
+            /**
+             * @brief Return the handle of `str`, copying it into the StringInterner if it is seen for the first time
+             * @param str the String to be interned
+             * @return the handle of the unique copy of `str`
+             */
+            CASIMIR_EXPORT InternedString intern(const StringView& str);
+
+            /**
+             * @brief Retrieve the handle of `str` without interning it
+             * @param str the String to look up
+             * @param result set to the handle of `str` if it has already been interned
+             * @return Whether or not `str` has already been interned
+             */
+            CASIMIR_EXPORT bool find(const StringView& str, InternedString& result) const;
+
+            /**
+             * @brief Return the number of Strings interned (the empty string excluded)
+             * @return the number of interned Strings
+             */
+            CASIMIR_EXPORT cuint size() const;
+
+            /**
+             * @brief Return the StringInterner shared by the whole process, for the names that aren't tied to a
+             * CasimirContext (it is never destroyed so that its handles stay valid until the end of the process)
+             * @return A reference to the process-wide StringInterner
+             */
+            CASIMIR_EXPORT static StringInterner& global();
+        };
+
+    }
+
+}
+
+namespace std {
+    /**
+     * @brief Defines the hash of an InternedString (computed once on interning) so that it can be used as a key in a
+     * hash_map in constant time
+     */
+    template<>
+    struct hash<Casimir::utilities::InternedString> {
+        inline std::size_t operator()(const Casimir::utilities::InternedString& str) const {
+            return (std::size_t) str.hash();
+        }
+    };
+}
+
+#endif
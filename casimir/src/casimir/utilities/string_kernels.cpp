@@ -0,0 +1,824 @@
+#include "string_kernels.hpp"
+#include "string.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CASIMIR_KERNELS_X86
+#define CASIMIR_KERNELS_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define CASIMIR_KERNELS_X86
+#define CASIMIR_KERNELS_TARGET(isa)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace Casimir::utilities::kernels {
+
+    typedef cuint (*FindFunction)(const char*, cuint, const char*, cuint);
+
+    static constexpr cuint s_notFound = String::notFound();
+
+    const CpuFeatures& cpuFeatures() {
+        static const CpuFeatures features = []() {
+            CpuFeatures result{false, false, false};
+#if defined(CASIMIR_KERNELS_X86) && defined(__GNUC__)
+            __builtin_cpu_init();
+            result.sse2 = __builtin_cpu_supports("sse2");
+            result.ssse3 = __builtin_cpu_supports("ssse3");
+            result.avx2 = __builtin_cpu_supports("avx2");
+#elif defined(CASIMIR_KERNELS_X86)
+            int info[4];
+            __cpuid(info, 1);
+            result.sse2 = (info[3] & (1 << 26)) != 0;
+            result.ssse3 = (info[2] & (1 << 9)) != 0;
+
+            // The OS must save the AVX registers on context switches
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            __cpuidex(info, 7, 0);
+            result.avx2 = osxsave && (info[1] & (1 << 5)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+#endif
+            return result;
+        }();
+        return features;
+    }
+
+    /**
+     * @brief Whether or not the candidate at `position` (whose first and last bytes already match) is an occurrence
+     */
+    static inline bool matchesAt(const char* haystack, cuint position, const char* needle, cuint needleLength) {
+        return needleLength <= 2 || memcmp(haystack + position + 1, needle + 1, needleLength - 2) == 0;
+    }
+
+    static cuint findForwardScalar(const char* haystack, cuint length, const char* needle, cuint needleLength) {
+        if (needleLength > length) return s_notFound;
+        const cuint candidates = length - needleLength + 1;
+        const char* current = haystack;
+        const char* end = haystack + candidates;
+        while (current < end) {
+            current = (const char*) memchr(current, needle[0], end - current);
+            if (current == nullptr) return s_notFound;
+            if (memcmp(current, needle, needleLength) == 0) return current - haystack;
+            ++current;
+        }
+        return s_notFound;
+    }
+
+    static cuint findBackwardScalar(const char* haystack, cuint length, const char* needle, cuint needleLength) {
+        if (needleLength > length) return s_notFound;
+        for (cuint position = length - needleLength + 1; position-- > 0;) {
+            if (haystack[position] == needle[0] && memcmp(haystack + position, needle, needleLength) == 0) {
+                return position;
+            }
+        }
+        return s_notFound;
+    }
+
+#ifdef CASIMIR_KERNELS_X86
+    static inline cuint lowestBit(std::uint32_t mask) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    static inline cuint highestBit(std::uint32_t mask) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse(&index, mask);
+        return index;
+#else
+        return 31 - __builtin_clz(mask);
+#endif
+    }
+
+    /*
+     * The vectorized searches compare a block of candidate positions at once against the first and the last byte of
+     * the needle, only the positions where both match are compared against the whole needle
+     */
+
+    CASIMIR_KERNELS_TARGET("sse2")
+    static cuint findForwardSse2(const char* haystack, cuint length, const char* needle, cuint needleLength) {
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[needleLength - 1]);
+        cuint i = 0;
+        for (; i + needleLength + 15 <= length; i += 16) {
+            const __m128i blockFirst = _mm_loadu_si128((const __m128i*) (haystack + i));
+            const __m128i blockLast = _mm_loadu_si128((const __m128i*) (haystack + i + needleLength - 1));
+            std::uint32_t mask = (std::uint32_t) _mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast)));
+            while (mask != 0) {
+                const cuint position = i + lowestBit(mask);
+                if (matchesAt(haystack, position, needle, needleLength)) return position;
+                mask &= mask - 1;
+            }
+        }
+        const cuint rest = findForwardScalar(haystack + i, length - i, needle, needleLength);
+        return rest == s_notFound ? s_notFound : i + rest;
+    }
+
+    CASIMIR_KERNELS_TARGET("sse2")
+    static cuint findBackwardSse2(const char* haystack, cuint length, const char* needle, cuint needleLength) {
+        if (needleLength > length) return s_notFound;
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[needleLength - 1]);
+        cuint candidates = length - needleLength + 1;
+        for (; candidates >= 16; candidates -= 16) {
+            const cuint base = candidates - 16;
+            const __m128i blockFirst = _mm_loadu_si128((const __m128i*) (haystack + base));
+            const __m128i blockLast = _mm_loadu_si128((const __m128i*) (haystack + base + needleLength - 1));
+            std::uint32_t mask = (std::uint32_t) _mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast)));
+            while (mask != 0) {
+                const cuint bit = highestBit(mask);
+                if (matchesAt(haystack, base + bit, needle, needleLength)) return base + bit;
+                mask &= ~(1U << bit);
+            }
+        }
+        return findBackwardScalar(haystack, candidates + needleLength - 1, needle, needleLength);
+    }
+
+    /**
+     * @brief Return the first occurrence among the candidates of `mask` (bit i is the position `base + i`)
+     */
+    static inline cuint firstMatch(const char* haystack, cuint base, std::uint32_t mask, const char* needle,
+                                   cuint needleLength) {
+        for (; mask != 0; mask &= mask - 1) {
+            const cuint position = base + lowestBit(mask);
+            if (matchesAt(haystack, position, needle, needleLength)) return position;
+        }
+        return s_notFound;
+    }
+
+    /**
+     * @brief Return the last occurrence among the candidates of `mask` (bit i is the position `base + i`)
+     */
+    static inline cuint lastMatch(const char* haystack, cuint base, std::uint32_t mask, const char* needle,
+                                  cuint needleLength) {
+        while (mask != 0) {
+            const cuint bit = highestBit(mask);
+            if (matchesAt(haystack, base + bit, needle, needleLength)) return base + bit;
+            mask &= ~(1U << bit);
+        }
+        return s_notFound;
+    }
+
+// Candidates among the 32 positions from `position` whose first and last bytes match the needle
+#define CASIMIR_AVX2_CANDIDATES(position) _mm256_and_si256(                                                            \
+        _mm256_cmpeq_epi8(first, _mm256_loadu_si256((const __m256i*) (haystack + (position)))),                      \
+        _mm256_cmpeq_epi8(last, _mm256_loadu_si256((const __m256i*) (haystack + (position) + needleLength - 1))))
+
+    /*
+     * The AVX2 searches test 64 positions per iteration and handle the remaining positions with a last block that
+     * overlaps the positions already tested (which are masked out)
+     */
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static cuint findForwardAvx2(const char* haystack, cuint length, const char* needle, cuint needleLength) {
+        const cuint candidates = length - needleLength + 1;
+        if (candidates < 32) return findForwardSse2(haystack, length, needle, needleLength);
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i last = _mm256_set1_epi8(needle[needleLength - 1]);
+        cuint i = 0;
+        for (; i + 64 <= candidates; i += 64) {
+            const __m256i low = CASIMIR_AVX2_CANDIDATES(i);
+            const __m256i high = CASIMIR_AVX2_CANDIDATES(i + 32);
+            const __m256i any = _mm256_or_si256(low, high);
+            if (_mm256_testz_si256(any, any)) continue;
+            cuint position = firstMatch(haystack, i, (std::uint32_t) _mm256_movemask_epi8(low), needle, needleLength);
+            if (position != s_notFound) return position;
+            position = firstMatch(haystack, i + 32, (std::uint32_t) _mm256_movemask_epi8(high), needle, needleLength);
+            if (position != s_notFound) return position;
+        }
+        for (; i + 32 <= candidates; i += 32) {
+            const std::uint32_t mask = (std::uint32_t) _mm256_movemask_epi8(CASIMIR_AVX2_CANDIDATES(i));
+            const cuint position = firstMatch(haystack, i, mask, needle, needleLength);
+            if (position != s_notFound) return position;
+        }
+        if (i == candidates) return s_notFound;
+        const cuint base = candidates - 32;
+        const std::uint32_t mask = (std::uint32_t) _mm256_movemask_epi8(CASIMIR_AVX2_CANDIDATES(base));
+        return firstMatch(haystack, base, mask & (~0U << (i - base)), needle, needleLength);
+    }
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static cuint findBackwardAvx2(const char* haystack, cuint length, const char* needle, cuint needleLength) {
+        const cuint candidates = length - needleLength + 1;
+        if (candidates < 32) return findBackwardSse2(haystack, length, needle, needleLength);
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i last = _mm256_set1_epi8(needle[needleLength - 1]);
+        cuint end = candidates; // The positions from `end` have been tested
+        for (; end >= 64; end -= 64) {
+            const __m256i low = CASIMIR_AVX2_CANDIDATES(end - 64);
+            const __m256i high = CASIMIR_AVX2_CANDIDATES(end - 32);
+            const __m256i any = _mm256_or_si256(low, high);
+            if (_mm256_testz_si256(any, any)) continue;
+            cuint position = lastMatch(haystack, end - 32, (std::uint32_t) _mm256_movemask_epi8(high), needle,
+                                       needleLength);
+            if (position != s_notFound) return position;
+            position = lastMatch(haystack, end - 64, (std::uint32_t) _mm256_movemask_epi8(low), needle, needleLength);
+            if (position != s_notFound) return position;
+        }
+        for (; end >= 32; end -= 32) {
+            const std::uint32_t mask = (std::uint32_t) _mm256_movemask_epi8(CASIMIR_AVX2_CANDIDATES(end - 32));
+            const cuint position = lastMatch(haystack, end - 32, mask, needle, needleLength);
+            if (position != s_notFound) return position;
+        }
+        if (end == 0) return s_notFound;
+        const std::uint32_t mask = (std::uint32_t) _mm256_movemask_epi8(CASIMIR_AVX2_CANDIDATES(0));
+        return lastMatch(haystack, 0, mask & ((1U << end) - 1), needle, needleLength);
+    }
+
+#undef CASIMIR_AVX2_CANDIDATES
+#endif
+
+    cuint findForward(const char* haystack, cuint length, const char* needle, cuint needleLength) {
+        static const FindFunction function = []() -> FindFunction {
+#ifdef CASIMIR_KERNELS_X86
+            if (cpuFeatures().avx2) return findForwardAvx2;
+            if (cpuFeatures().sse2) return findForwardSse2;
+#endif
+            return findForwardScalar;
+        }();
+        if (needleLength > length) return s_notFound;
+
+        // The C library already provides a vectorized search of a single byte
+        if (needleLength == 1) {
+            const char* position = (const char*) memchr(haystack, needle[0], length);
+            return position == nullptr ? s_notFound : position - haystack;
+        }
+        return function(haystack, length, needle, needleLength);
+    }
+
+    cuint findBackward(const char* haystack, cuint length, const char* needle, cuint needleLength) {
+        static const FindFunction function = []() -> FindFunction {
+#ifdef CASIMIR_KERNELS_X86
+            if (cpuFeatures().avx2) return findBackwardAvx2;
+            if (cpuFeatures().sse2) return findBackwardSse2;
+#endif
+            return findBackwardScalar;
+        }();
+        if (needleLength > length) return s_notFound;
+        return function(haystack, length, needle, needleLength);
+    }
+
+    typedef cuint (*FindInSetsFunction)(const char*, cuint, const ByteSet&, const ByteSet&, std::uint32_t*);
+
+    static cuint findAllInSetsScalar(const char* data, cuint length, const ByteSet& first, const ByteSet& second,
+                                     std::uint32_t* positions) {
+        cuint count = 0;
+        for (cuint i = 0; i < length; ++i) {
+            if (first.contains((ubyte) data[i]) && (i + 1 == length || second.contains((ubyte) data[i + 1]))) {
+                positions[count++] = (std::uint32_t) i;
+            }
+        }
+        return count;
+    }
+
+#ifdef CASIMIR_KERNELS_X86
+    /*
+     * The vectorized membership test looks the row of each byte up with a byte shuffle on its low nibble (in the
+     * table of the bytes below or above 0x80 according to its sign) and the bit of its high nibble with a second
+     * shuffle. The bytes at i and i + 1 of a block are tested at once with two overlapping loads
+     */
+
+    /**
+     * @brief Append the positions `base + i` of the bits i of `mask` to `positions`
+     */
+    static inline cuint appendPositions(std::uint32_t mask, cuint base, std::uint32_t* positions) {
+        cuint count = 0;
+        for (; mask != 0; mask &= mask - 1) positions[count++] = (std::uint32_t) (base + lowestBit(mask));
+        return count;
+    }
+
+    /**
+     * @brief The tables of a ByteSet loaded in vector registers
+     */
+    struct ByteSetSsse3 {
+        __m128i rowsLow;
+        __m128i rowsHigh;
+    };
+
+    struct ByteSetAvx2 {
+        __m256i rowsLow;
+        __m256i rowsHigh;
+    };
+
+    CASIMIR_KERNELS_TARGET("ssse3")
+    static inline ByteSetSsse3 loadSsse3(const ByteSet& set) {
+        return {_mm_load_si128((const __m128i*) set.rows[0]), _mm_load_si128((const __m128i*) set.rows[1])};
+    }
+
+    CASIMIR_KERNELS_TARGET("ssse3")
+    static inline std::uint32_t inSetSsse3(const char* data, const ByteSetSsse3& set) {
+        const __m128i value = _mm_loadu_si128((const __m128i*) data);
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        const __m128i low = _mm_and_si128(value, nibble);
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(value, 4), nibble);
+        const __m128i above = _mm_cmplt_epi8(value, _mm_setzero_si128());
+        const __m128i row = _mm_or_si128(_mm_andnot_si128(above, _mm_shuffle_epi8(set.rowsLow, low)),
+                                         _mm_and_si128(above, _mm_shuffle_epi8(set.rowsHigh, low)));
+        const __m128i bit = _mm_shuffle_epi8(bits, high);
+        return (std::uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(row, bit), bit));
+    }
+
+    CASIMIR_KERNELS_TARGET("ssse3")
+    static inline cuint findAllInSetsSsse3(const char* data, cuint length, const ByteSet& first,
+                                           const ByteSet& second, std::uint32_t* positions) {
+        if (length < 17) return findAllInSetsScalar(data, length, first, second, positions);
+        const ByteSetSsse3 firstRegisters = loadSsse3(first);
+        const ByteSetSsse3 secondRegisters = loadSsse3(second);
+        const auto candidates = [&](cuint position) CASIMIR_KERNELS_TARGET("ssse3") {
+            return inSetSsse3(data + position, firstRegisters) & inSetSsse3(data + position + 1, secondRegisters);
+        };
+
+        // The last byte has no successor, it is handled with the scalar test
+        const cuint blocksLength = length - 1;
+        cuint count = 0;
+        cuint i = 0;
+        for (; i + 16 <= blocksLength; i += 16) count += appendPositions(candidates(i), i, positions + count);
+
+        // The last block overlaps the previous one, whose positions are already reported
+        if (i < blocksLength) {
+            const std::uint32_t mask = candidates(blocksLength - 16) & (0xFFFFFFFFU << (i - (blocksLength - 16)));
+            count += appendPositions(mask, blocksLength - 16, positions + count);
+        }
+        if (first.contains((ubyte) data[blocksLength])) positions[count++] = (std::uint32_t) blocksLength;
+        return count;
+    }
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static inline ByteSetAvx2 loadAvx2(const ByteSet& set) {
+        return {_mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) set.rows[0])),
+                _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) set.rows[1]))};
+    }
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static inline std::uint32_t inSetAvx2(const char* data, const ByteSetAvx2& set) {
+        const __m256i value = _mm256_loadu_si256((const __m256i*) data);
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                              1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        const __m256i low = _mm256_and_si256(value, nibble);
+        const __m256i high = _mm256_and_si256(_mm256_srli_epi16(value, 4), nibble);
+
+        // The sign of each byte selects its table
+        const __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(set.rowsLow, low),
+                                               _mm256_shuffle_epi8(set.rowsHigh, low), value);
+        const __m256i bit = _mm256_shuffle_epi8(bits, high);
+        return (std::uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit));
+    }
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static cuint findAllInSetsAvx2(const char* data, cuint length, const ByteSet& first, const ByteSet& second,
+                                   std::uint32_t* positions) {
+        if (length < 33) return findAllInSetsSsse3(data, length, first, second, positions);
+        const ByteSetAvx2 firstRegisters = loadAvx2(first);
+        const ByteSetAvx2 secondRegisters = loadAvx2(second);
+        const auto candidates = [&](cuint position) CASIMIR_KERNELS_TARGET("avx2") {
+            return inSetAvx2(data + position, firstRegisters) & inSetAvx2(data + position + 1, secondRegisters);
+        };
+        const cuint blocksLength = length - 1;
+        cuint count = 0;
+        cuint i = 0;
+        for (; i + 32 <= blocksLength; i += 32) count += appendPositions(candidates(i), i, positions + count);
+        if (i < blocksLength) {
+            const std::uint32_t mask = candidates(blocksLength - 32) & (0xFFFFFFFFU << (i - (blocksLength - 32)));
+            count += appendPositions(mask, blocksLength - 32, positions + count);
+        }
+        if (first.contains((ubyte) data[blocksLength])) positions[count++] = (std::uint32_t) blocksLength;
+        return count;
+    }
+#endif
+
+    cuint findAllInSets(const char* data, cuint length, const ByteSet& first, const ByteSet& second,
+                        std::uint32_t* positions) {
+        static const FindInSetsFunction function = []() -> FindInSetsFunction {
+#ifdef CASIMIR_KERNELS_X86
+            if (cpuFeatures().avx2) return findAllInSetsAvx2;
+            if (cpuFeatures().ssse3) return findAllInSetsSsse3;
+#endif
+            return findAllInSetsScalar;
+        }();
+        return function(data, length, first, second, positions);
+    }
+
+    typedef void (*EncodeHexFunction)(const char*, cuint, char*);
+    typedef cuint (*DecodeHexFunction)(const char*, cuint, char*);
+
+    static constexpr char s_hexAlphabet[] = "0123456789abcdef";
+
+    /**
+     * @brief Value of each character as an hexadecimal digit (0xFF if it isn't one)
+     */
+    struct HexTable {
+        ubyte values[256];
+
+        constexpr HexTable() : values() {
+            for (cuint i = 0; i < 256; ++i) values[i] = 0xFF;
+            for (cuint i = 0; i < 10; ++i) values['0' + i] = (ubyte) i;
+            for (cuint i = 0; i < 6; ++i) values['a' + i] = values['A' + i] = (ubyte) (10 + i);
+        }
+    };
+
+    static constexpr HexTable s_hexTable{};
+
+    static inline void encodeHexScalar(const char* data, cuint length, char* output) {
+        for (cuint i = 0; i < length; ++i) {
+            const ubyte value = (ubyte) data[i];
+            output[2 * i] = s_hexAlphabet[value >> 4U];
+            output[2 * i + 1] = s_hexAlphabet[value & 0x0FU];
+        }
+    }
+
+    static inline cuint decodeHexScalar(const char* hex, cuint length, char* output) {
+        for (cuint i = 0; i + 1 < length; i += 2) {
+            const ubyte high = s_hexTable.values[(ubyte) hex[i]];
+            const ubyte low = s_hexTable.values[(ubyte) hex[i + 1]];
+            if (high == 0xFF) return i;
+            if (low == 0xFF) return i + 1;
+            output[i / 2] = (char) (high << 4U | low);
+        }
+        return s_notFound;
+    }
+
+#ifdef CASIMIR_KERNELS_X86
+    /*
+     * The vectorized encoders look the hexadecimal digits of both nibbles up with a byte shuffle and interleave them.
+     * The decoders compute the value of every character (digits and letters in parallel), check that each of them is
+     * an hexadecimal digit and merge the pairs with a multiply-add (high * 16 + low)
+     * The narrower kernels finishing the AVX2 ones are inlined: a call to legacy SSE code right after AVX code costs
+     * more than encoding a whole Uuid
+     */
+
+    CASIMIR_KERNELS_TARGET("ssse3")
+    static inline void encodeHexSsse3(const char* data, cuint length, char* output) {
+        const __m128i alphabet = _mm_loadu_si128((const __m128i*) s_hexAlphabet);
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        cuint i = 0;
+        for (; i + 16 <= length; i += 16) {
+            const __m128i value = _mm_loadu_si128((const __m128i*) (data + i));
+            const __m128i high = _mm_shuffle_epi8(alphabet, _mm_and_si128(_mm_srli_epi16(value, 4), nibble));
+            const __m128i low = _mm_shuffle_epi8(alphabet, _mm_and_si128(value, nibble));
+            _mm_storeu_si128((__m128i*) (output + 2 * i), _mm_unpacklo_epi8(high, low));
+            _mm_storeu_si128((__m128i*) (output + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+        }
+        encodeHexScalar(data + i, length - i, output + 2 * i);
+    }
+
+    /**
+     * @brief Return the value of 16 hexadecimal characters and set the bits of `invalid` of those that aren't
+     */
+    CASIMIR_KERNELS_TARGET("ssse3")
+    static inline __m128i hexNibbles(__m128i characters, std::uint32_t& invalid) {
+        const __m128i digit = _mm_sub_epi8(characters, _mm_set1_epi8('0'));
+        const __m128i letter = _mm_sub_epi8(_mm_or_si128(characters, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+        const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+        invalid = ~(std::uint32_t) _mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) & 0xFFFFU;
+        return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                            _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+    }
+
+    CASIMIR_KERNELS_TARGET("ssse3")
+    static inline cuint decodeHexSsse3(const char* hex, cuint length, char* output) {
+        const __m128i weights = _mm_set1_epi16(0x0110);
+        cuint i = 0;
+        for (; i + 32 <= length; i += 32) {
+            std::uint32_t invalidLow, invalidHigh;
+            const __m128i low = hexNibbles(_mm_loadu_si128((const __m128i*) (hex + i)), invalidLow);
+            const __m128i high = hexNibbles(_mm_loadu_si128((const __m128i*) (hex + i + 16)), invalidHigh);
+            if ((invalidLow | invalidHigh) != 0) {
+                return i + (invalidLow != 0 ? lowestBit(invalidLow) : 16 + lowestBit(invalidHigh));
+            }
+            _mm_storeu_si128((__m128i*) (output + i / 2),
+                             _mm_packus_epi16(_mm_maddubs_epi16(low, weights), _mm_maddubs_epi16(high, weights)));
+        }
+        const cuint rest = decodeHexScalar(hex + i, length - i, output + i / 2);
+        return rest == s_notFound ? s_notFound : i + rest;
+    }
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static void encodeHexAvx2(const char* data, cuint length, char* output) {
+        const __m256i alphabet = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) s_hexAlphabet));
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        cuint i = 0;
+        for (; i + 32 <= length; i += 32) {
+            const __m256i value = _mm256_loadu_si256((const __m256i*) (data + i));
+            const __m256i high = _mm256_shuffle_epi8(alphabet, _mm256_and_si256(_mm256_srli_epi16(value, 4), nibble));
+            const __m256i low = _mm256_shuffle_epi8(alphabet, _mm256_and_si256(value, nibble));
+
+            // The interleaving works within each 128-bit lane, the lanes are put back in order
+            const __m256i first = _mm256_unpacklo_epi8(high, low);
+            const __m256i second = _mm256_unpackhi_epi8(high, low);
+            _mm256_storeu_si256((__m256i*) (output + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+            _mm256_storeu_si256((__m256i*) (output + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+        }
+        encodeHexSsse3(data + i, length - i, output + 2 * i);
+    }
+
+    /**
+     * @brief Return the value of 32 hexadecimal characters and set the bits of `invalid` of those that aren't
+     */
+    CASIMIR_KERNELS_TARGET("avx2")
+    static inline __m256i hexNibbles(__m256i characters, std::uint32_t& invalid) {
+        const __m256i digit = _mm256_sub_epi8(characters, _mm256_set1_epi8('0'));
+        const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(characters, _mm256_set1_epi8(0x20)),
+                                               _mm256_set1_epi8('a'));
+        const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+        const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+        invalid = ~(std::uint32_t) _mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter));
+        return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+                               _mm256_and_si256(isLetter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+    }
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static cuint decodeHexAvx2(const char* hex, cuint length, char* output) {
+        const __m256i weights = _mm256_set1_epi16(0x0110);
+        cuint i = 0;
+        for (; i + 64 <= length; i += 64) {
+            std::uint32_t invalidLow, invalidHigh;
+            const __m256i low = hexNibbles(_mm256_loadu_si256((const __m256i*) (hex + i)), invalidLow);
+            const __m256i high = hexNibbles(_mm256_loadu_si256((const __m256i*) (hex + i + 32)), invalidHigh);
+            if ((invalidLow | invalidHigh) != 0) {
+                return i + (invalidLow != 0 ? lowestBit(invalidLow) : 32 + lowestBit(invalidHigh));
+            }
+
+            // The packing works within each 128-bit lane, the 64-bit quarters are put back in order
+            const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(low, weights),
+                                                       _mm256_maddubs_epi16(high, weights));
+            _mm256_storeu_si256((__m256i*) (output + i / 2), _mm256_permute4x64_epi64(packed, 0xD8));
+        }
+        const cuint rest = decodeHexSsse3(hex + i, length - i, output + i / 2);
+        return rest == s_notFound ? s_notFound : i + rest;
+    }
+#endif
+
+    void encodeHex(const char* data, cuint length, char* output) {
+        static const EncodeHexFunction function = []() -> EncodeHexFunction {
+#ifdef CASIMIR_KERNELS_X86
+            if (cpuFeatures().avx2) return encodeHexAvx2;
+            if (cpuFeatures().ssse3) return encodeHexSsse3;
+#endif
+            return encodeHexScalar;
+        }();
+        function(data, length, output);
+    }
+
+    cuint decodeHex(const char* hex, cuint length, char* output) {
+        static const DecodeHexFunction function = []() -> DecodeHexFunction {
+#ifdef CASIMIR_KERNELS_X86
+            if (cpuFeatures().avx2) return decodeHexAvx2;
+            if (cpuFeatures().ssse3) return decodeHexSsse3;
+#endif
+            return decodeHexScalar;
+        }();
+        return function(hex, length, output);
+    }
+
+    typedef cuint (*ScanFunction)(const char*, cuint);
+    typedef void (*ConvertCaseFunction)(const char*, cuint, char*, bool);
+    typedef bool (*IsAsciiFunction)(const char*, cuint);
+    typedef cuint (*CountByteFunction)(const char*, cuint, char);
+
+    static inline cuint findFirstNotHexScalar(const char* data, cuint length) {
+        for (cuint i = 0; i < length; ++i) {
+            if (s_hexTable.values[(ubyte) data[i]] == 0xFF) return i;
+        }
+        return s_notFound;
+    }
+
+    static inline void convertCaseScalar(const char* data, cuint length, char* output, bool upper) {
+        const char first = upper ? 'a' : 'A';
+        for (cuint i = 0; i < length; ++i) {
+            const char value = data[i];
+            output[i] = (char) ((ubyte) (value - first) < 26 ? value ^ 0x20 : value);
+        }
+    }
+
+    static inline bool isAsciiScalar(const char* data, cuint length) {
+        ubyte bits = 0;
+        for (cuint i = 0; i < length; ++i) bits |= (ubyte) data[i];
+        return bits < 0x80;
+    }
+
+    static inline cuint countByteScalar(const char* data, cuint length, char value) {
+        cuint count = 0;
+        for (cuint i = 0; i < length; ++i) count += data[i] == value;
+        return count;
+    }
+
+#ifdef CASIMIR_KERNELS_X86
+    /*
+     * The character classes are ranges tested with a single comparison: `c - first` is below `size` as an unsigned
+     * byte (SSE2 has no unsigned comparison, so the bytes are shifted by 0x80 and compared as signed bytes instead).
+     * The case of the letters is flipped by their bit 0x20. As the conversion is idempotent the last partial block
+     * overlaps the previous one instead of falling back on the scalar loop, even in place.
+     * The bytes are counted in 8-bit lanes, summed up before they overflow
+     */
+
+    /**
+     * @brief Set the bytes of 16 characters that are in ['first', 'first' + size)
+     */
+    CASIMIR_KERNELS_TARGET("sse2")
+    static inline __m128i inRange(__m128i characters, char first, char size) {
+        return _mm_cmplt_epi8(_mm_add_epi8(characters, _mm_set1_epi8((char) (0x80 - first))),
+                              _mm_set1_epi8((char) (0x80 + size)));
+    }
+
+    /**
+     * @brief Return the mask of the characters among 16 that aren't hexadecimal digits
+     */
+    CASIMIR_KERNELS_TARGET("sse2")
+    static inline std::uint32_t notHex(const char* data) {
+        const __m128i characters = _mm_loadu_si128((const __m128i*) data);
+        const __m128i isHex = _mm_or_si128(inRange(characters, '0', 10),
+                                           inRange(_mm_or_si128(characters, _mm_set1_epi8(0x20)), 'a', 6));
+        return ~(std::uint32_t) _mm_movemask_epi8(isHex) & 0xFFFFU;
+    }
+
+    CASIMIR_KERNELS_TARGET("sse2")
+    static inline cuint findFirstNotHexSse2(const char* data, cuint length) {
+        if (length < 16) return findFirstNotHexScalar(data, length);
+        cuint i = 0;
+        for (; i + 16 <= length; i += 16) {
+            const std::uint32_t mask = notHex(data + i);
+            if (mask != 0) return i + lowestBit(mask);
+        }
+
+        // The characters before `i` are already known to be valid
+        if (i == length) return s_notFound;
+        const std::uint32_t mask = notHex(data + length - 16);
+        return mask != 0 ? length - 16 + lowestBit(mask) : s_notFound;
+    }
+
+    CASIMIR_KERNELS_TARGET("sse2")
+    static inline void convertCaseBlockSse2(const char* data, char* output, char first) {
+        const __m128i characters = _mm_loadu_si128((const __m128i*) data);
+        const __m128i flip = _mm_and_si128(inRange(characters, first, 26), _mm_set1_epi8(0x20));
+        _mm_storeu_si128((__m128i*) output, _mm_xor_si128(characters, flip));
+    }
+
+    CASIMIR_KERNELS_TARGET("sse2")
+    static inline void convertCaseSse2(const char* data, cuint length, char* output, bool upper) {
+        if (length < 16) return convertCaseScalar(data, length, output, upper);
+        const char first = upper ? 'a' : 'A';
+        for (cuint i = 0; i + 16 <= length; i += 16) convertCaseBlockSse2(data + i, output + i, first);
+        if (length % 16 != 0) convertCaseBlockSse2(data + length - 16, output + length - 16, first);
+    }
+
+    CASIMIR_KERNELS_TARGET("sse2")
+    static inline bool isAsciiSse2(const char* data, cuint length) {
+        __m128i bits = _mm_setzero_si128();
+        cuint i = 0;
+        for (; i + 16 <= length; i += 16) bits = _mm_or_si128(bits, _mm_loadu_si128((const __m128i*) (data + i)));
+        return _mm_movemask_epi8(bits) == 0 && isAsciiScalar(data + i, length - i);
+    }
+
+    CASIMIR_KERNELS_TARGET("sse2")
+    static inline cuint countByteSse2(const char* data, cuint length, char value) {
+        const __m128i searched = _mm_set1_epi8(value);
+        cuint count = 0;
+        cuint i = 0;
+        while (i + 16 <= length) {
+            // Each 8-bit lane counts up to 255 matches
+            __m128i counts = _mm_setzero_si128();
+            for (cuint blocks = 0; blocks < 255 && i + 16 <= length; ++blocks, i += 16) {
+                const __m128i characters = _mm_loadu_si128((const __m128i*) (data + i));
+                counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(characters, searched));
+            }
+            const __m128i sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+            count += (cuint) _mm_cvtsi128_si32(sums) + (cuint) _mm_cvtsi128_si32(_mm_unpackhi_epi64(sums, sums));
+        }
+        return count + countByteScalar(data + i, length - i, value);
+    }
+
+    /**
+     * @brief Set the bytes of 32 characters that are in ['first', 'first' + size)
+     */
+    CASIMIR_KERNELS_TARGET("avx2")
+    static inline __m256i inRange(__m256i characters, char first, char size) {
+        return _mm256_cmpgt_epi8(_mm256_set1_epi8((char) (0x80 + size)),
+                                 _mm256_add_epi8(characters, _mm256_set1_epi8((char) (0x80 - first))));
+    }
+
+    /**
+     * @brief Return the mask of the characters among 32 that aren't hexadecimal digits
+     */
+    CASIMIR_KERNELS_TARGET("avx2")
+    static inline std::uint32_t notHexAvx2(const char* data) {
+        const __m256i characters = _mm256_loadu_si256((const __m256i*) data);
+        const __m256i isHex = _mm256_or_si256(inRange(characters, '0', 10),
+                                              inRange(_mm256_or_si256(characters, _mm256_set1_epi8(0x20)), 'a', 6));
+        return ~(std::uint32_t) _mm256_movemask_epi8(isHex);
+    }
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static cuint findFirstNotHexAvx2(const char* data, cuint length) {
+        if (length < 32) return findFirstNotHexSse2(data, length);
+        cuint i = 0;
+        for (; i + 32 <= length; i += 32) {
+            const std::uint32_t mask = notHexAvx2(data + i);
+            if (mask != 0) return i + lowestBit(mask);
+        }
+        if (i == length) return s_notFound;
+        const std::uint32_t mask = notHexAvx2(data + length - 32);
+        return mask != 0 ? length - 32 + lowestBit(mask) : s_notFound;
+    }
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static inline void convertCaseBlockAvx2(const char* data, char* output, char first) {
+        const __m256i characters = _mm256_loadu_si256((const __m256i*) data);
+        const __m256i flip = _mm256_and_si256(inRange(characters, first, 26), _mm256_set1_epi8(0x20));
+        _mm256_storeu_si256((__m256i*) output, _mm256_xor_si256(characters, flip));
+    }
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static void convertCaseAvx2(const char* data, cuint length, char* output, bool upper) {
+        if (length < 32) return convertCaseSse2(data, length, output, upper);
+        const char first = upper ? 'a' : 'A';
+        for (cuint i = 0; i + 32 <= length; i += 32) convertCaseBlockAvx2(data + i, output + i, first);
+        if (length % 32 != 0) convertCaseBlockAvx2(data + length - 32, output + length - 32, first);
+    }
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static bool isAsciiAvx2(const char* data, cuint length) {
+        __m256i bits = _mm256_setzero_si256();
+        cuint i = 0;
+        for (; i + 32 <= length; i += 32) {
+            bits = _mm256_or_si256(bits, _mm256_loadu_si256((const __m256i*) (data + i)));
+        }
+        return _mm256_movemask_epi8(bits) == 0 && isAsciiSse2(data + i, length - i);
+    }
+
+    CASIMIR_KERNELS_TARGET("avx2")
+    static cuint countByteAvx2(const char* data, cuint length, char value) {
+        const __m256i searched = _mm256_set1_epi8(value);
+        cuint count = 0;
+        cuint i = 0;
+        while (i + 32 <= length) {
+            __m256i counts = _mm256_setzero_si256();
+            for (cuint blocks = 0; blocks < 255 && i + 32 <= length; ++blocks, i += 32) {
+                const __m256i characters = _mm256_loadu_si256((const __m256i*) (data + i));
+                counts = _mm256_sub_epi8(counts, _mm256_cmpeq_epi8(characters, searched));
+            }
+            // The 64-bit sums are folded into 128 bits (_mm256_extract_epi64 does not exist on i386)
+            const __m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+            const __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+            count += (cuint) _mm_cvtsi128_si32(halves) + (cuint) _mm_cvtsi128_si32(_mm_unpackhi_epi64(halves, halves));
+        }
+        return count + countByteSse2(data + i, length - i, value);
+    }
+#endif
+
+    cuint findFirstNotHex(const char* data, cuint length) {
+        static const ScanFunction function = []() -> ScanFunction {
+#ifdef CASIMIR_KERNELS_X86
+            if (cpuFeatures().avx2) return findFirstNotHexAvx2;
+            if (cpuFeatures().sse2) return findFirstNotHexSse2;
+#endif
+            return findFirstNotHexScalar;
+        }();
+        return function(data, length);
+    }
+
+    void convertCase(const char* data, cuint length, char* output, bool upper) {
+        static const ConvertCaseFunction function = []() -> ConvertCaseFunction {
+#ifdef CASIMIR_KERNELS_X86
+            if (cpuFeatures().avx2) return convertCaseAvx2;
+            if (cpuFeatures().sse2) return convertCaseSse2;
+#endif
+            return convertCaseScalar;
+        }();
+        function(data, length, output, upper);
+    }
+
+    bool isAscii(const char* data, cuint length) {
+        static const IsAsciiFunction function = []() -> IsAsciiFunction {
+#ifdef CASIMIR_KERNELS_X86
+            if (cpuFeatures().avx2) return isAsciiAvx2;
+            if (cpuFeatures().sse2) return isAsciiSse2;
+#endif
+            return isAsciiScalar;
+        }();
+        return function(data, length);
+    }
+
+    cuint countByte(const char* data, cuint length, char value) {
+        static const CountByteFunction function = []() -> CountByteFunction {
+#ifdef CASIMIR_KERNELS_X86
+            if (cpuFeatures().avx2) return countByteAvx2;
+            if (cpuFeatures().sse2) return countByteSse2;
+#endif
+            return countByteScalar;
+        }();
+        return function(data, length, value);
+    }
+
+}
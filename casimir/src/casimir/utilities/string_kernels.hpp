@@ -0,0 +1,157 @@
+#ifndef CASIMIR_STRING_KERNELS_HPP_
+#define CASIMIR_STRING_KERNELS_HPP_
+
+#include <cstdint>
+
+#include "../casimir.hpp"
+
+namespace Casimir {
+
+    namespace utilities {
+
+        /**
+         * @brief Byte processing kernels behind utilities::String. Each kernel has a portable implementation and,
+         * on x86, vectorized ones selected at runtime according to the instruction sets supported by the CPU
+         */
+        namespace kernels {
+
+            /**
+             * @brief The instruction sets used by the kernels that the CPU supports
+             */
+            struct CpuFeatures {
+                bool sse2;
+                bool ssse3;
+                bool avx2;
+            };
+
+            /**
+             * @brief Return the instruction sets supported by the CPU (detected once)
+             * @return the supported instruction sets
+             */
+            const CpuFeatures& cpuFeatures();
+
+            /**
+             * @brief Find the first occurrence of `needle` in `haystack`
+             * @param haystack the bytes searched
+             * @param length the number of bytes of `haystack`
+             * @param needle the bytes to be found
+             * @param needleLength the number of bytes of `needle` (at least 1)
+             * @return the position of the first occurrence, String::notFound() if there is none
+             */
+            cuint findForward(const char* haystack, cuint length, const char* needle, cuint needleLength);
+
+            /**
+             * @brief Find the last occurrence of `needle` in `haystack`
+             * @param haystack the bytes searched
+             * @param length the number of bytes of `haystack`
+             * @param needle the bytes to be found
+             * @param needleLength the number of bytes of `needle` (at least 1)
+             * @return the position of the last occurrence, String::notFound() if there is none
+             */
+            cuint findBackward(const char* haystack, cuint length, const char* needle, cuint needleLength);
+
+            /**
+             * @brief Set of byte values, laid out for the vectorized membership test: the bit `(b >> 4) & 7` of
+             * `rows[b >> 7][b & 15]` is set when `b` belongs to the set
+             */
+            struct ByteSet {
+                alignas(16) ubyte rows[2][16] = {};
+
+                /**
+                 * @brief Add the byte `value` to the set
+                 * @param value the byte to be added
+                 */
+                inline void add(ubyte value) {
+                    rows[value >> 7U][value & 15U] |= (ubyte) (1U << ((value >> 4U) & 7U));
+                }
+
+                /**
+                 * @brief Add all the bytes to the set
+                 */
+                inline void fill() {
+                    for (auto& row : rows) {
+                        for (ubyte& bits : row) bits = 0xFF;
+                    }
+                }
+
+                /**
+                 * @brief Whether or not the byte `value` belongs to the set
+                 * @param value the byte to check
+                 * @return the result of the above check
+                 */
+                inline bool contains(ubyte value) const {
+                    return (rows[value >> 7U][value & 15U] & (1U << ((value >> 4U) & 7U))) != 0;
+                }
+            };
+
+            /**
+             * @brief Find the positions i of `data` whose byte belongs to `first` and whose next byte (if any) belongs
+             * to `second`, the candidate positions of a set of patterns
+             * @param data the bytes searched
+             * @param length the number of bytes of `data` (less than 2^32)
+             * @param first the first bytes of the patterns
+             * @param second the second bytes of the patterns (all the bytes if a pattern has a single byte)
+             * @param positions receives the increasing positions found, must be able to hold `length` positions
+             * @return the number of positions written
+             */
+            cuint findAllInSets(const char* data, cuint length, const ByteSet& first, const ByteSet& second,
+                                std::uint32_t* positions);
+
+            /**
+             * @brief Write the lowercase hexadecimal representation of `data` (two characters per byte)
+             * @param data the bytes to be encoded
+             * @param length the number of bytes of `data`
+             * @param output where the `2 * length` characters are written
+             */
+            void encodeHex(const char* data, cuint length, char* output);
+
+            /**
+             * @brief Decode hexadecimal characters (either case) two by two, stopping at the first invalid character
+             * @param hex the characters to be decoded
+             * @param length the number of characters of `hex` (even)
+             * @param output where the `length / 2` bytes are written
+             * @return the position of the first invalid character, String::notFound() if they are all valid
+             */
+            cuint decodeHex(const char* hex, cuint length, char* output);
+
+            /**
+             * @brief Find the first character of `data` that isn't an hexadecimal digit (either case)
+             * @param data the characters checked
+             * @param length the number of characters of `data`
+             * @return the position of the first invalid character, String::notFound() if they are all valid
+             */
+            cuint findFirstNotHex(const char* data, cuint length);
+
+            /**
+             * @brief Convert the ASCII letters of `data` to uppercase or to lowercase, the other bytes are copied
+             * @param data the characters to be converted
+             * @param length the number of characters of `data`
+             * @param output where the `length` converted characters are written, may be `data` itself
+             * @param upper whether the letters are converted to uppercase (otherwise to lowercase)
+             */
+            void convertCase(const char* data, cuint length, char* output, bool upper);
+
+            /**
+             * @brief Whether or not all the bytes of `data` are ASCII characters (below 0x80)
+             * @param data the bytes checked
+             * @param length the number of bytes of `data`
+             * @return the result of the above check
+             */
+            bool isAscii(const char* data, cuint length);
+
+            /**
+             * @brief Count the occurrences of the byte `value` in `data`
+             * @param data the bytes searched
+             * @param length the number of bytes of `data`
+             * @param value the byte to be counted
+             * @return the number of occurrences
+             */
+            cuint countByte(const char* data, cuint length, char value);
+
+        }
+
+    }
+
+}
+
+#endif
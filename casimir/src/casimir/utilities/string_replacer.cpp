@@ -0,0 +1,121 @@
+#include "string_replacer.hpp"
+#include "string_kernels.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace Casimir {
+
+    using namespace literals;
+
+    CASIMIR_EXPORT utilities::StringReplacer::StringReplacer(
+            const std::vector<std::pair<utilities::StringView, utilities::StringView>>& replacements)
+        : m_buckets(), m_singleBytes(true), m_shrinking(true), m_firstBytes(), m_secondBytes()
+    {
+        for (const auto& replacement : replacements) {
+            if (replacement.first.isEmpty()) continue;
+            m_patterns.push_back({String(replacement.first), String(replacement.second)});
+        }
+
+        // The stable sort keeps the first replacement of a pattern listed twice before the other ones
+        std::stable_sort(m_patterns.begin(), m_patterns.end(), [](const Pattern& a, const Pattern& b) {
+            const auto firstA = (ubyte) a.pattern[0];
+            const auto firstB = (ubyte) b.pattern[0];
+            return firstA != firstB ? firstA < firstB : a.pattern.length() > b.pattern.length();
+        });
+        for (const Pattern& pattern : m_patterns) {
+            ++m_buckets[(ubyte) pattern.pattern[0] + 1];
+            m_singleBytes = m_singleBytes && pattern.pattern.length() == 1;
+            m_shrinking = m_shrinking && pattern.replacement.length() <= pattern.pattern.length();
+        }
+        for (cuint i = 1; i < 257; ++i) m_buckets[i] += m_buckets[i - 1];
+
+        kernels::ByteSet firstBytes;
+        kernels::ByteSet secondBytes;
+        for (const Pattern& pattern : m_patterns) {
+            firstBytes.add((ubyte) pattern.pattern[0]);
+            if (pattern.pattern.length() == 1) secondBytes.fill();
+            else secondBytes.add((ubyte) pattern.pattern[1]);
+        }
+        memcpy(m_firstBytes, firstBytes.rows, sizeof(m_firstBytes));
+        memcpy(m_secondBytes, secondBytes.rows, sizeof(m_secondBytes));
+    }
+
+    inline cuint utilities::StringReplacer::match(const utilities::StringView& text, cuint position) const {
+        const auto first = (ubyte) text.data()[position];
+        const cuint begin = m_buckets[first];
+        const cuint end = m_buckets[first + 1];
+
+        // A single byte pattern always matches its byte (the first one listed is the one kept)
+        if (m_singleBytes) return begin != end ? begin : m_patterns.size();
+        for (cuint i = begin; i < end; ++i) {
+            const String& pattern = m_patterns[i].pattern;
+            if (pattern.length() <= text.length() - position &&
+                memcmp(text.data() + position + 1, pattern.c_str() + 1, (size_t) pattern.length() - 1) == 0) {
+                return i;
+            }
+        }
+        return m_patterns.size();
+    }
+
+    template<typename Function>
+    void utilities::StringReplacer::forEachMatch(const utilities::StringView& text, Function&& function) const {
+        // The bytes starting a pattern are located by chunks, most of the bytes being skipped by blocks
+        static constexpr cuint chunkLength = 4096;
+        std::uint32_t candidates[chunkLength];
+        kernels::ByteSet firstBytes;
+        kernels::ByteSet secondBytes;
+        memcpy(firstBytes.rows, m_firstBytes, sizeof(m_firstBytes));
+        memcpy(secondBytes.rows, m_secondBytes, sizeof(m_secondBytes));
+        cuint position = 0;
+        for (cuint chunk = 0; chunk < text.length(); chunk += chunkLength) {
+            const cuint count = kernels::findAllInSets(text.data() + chunk,
+                                                       std::min(chunkLength, text.length() - chunk), firstBytes,
+                                                       secondBytes, candidates);
+            for (cuint i = 0; i < count; ++i) {
+                // The candidates inside the last occurrence replaced are skipped
+                const cuint candidate = chunk + candidates[i];
+                if (candidate < position) continue;
+                const cuint pattern = match(text, candidate);
+                if (pattern == m_patterns.size()) continue;
+                function(candidate, m_patterns[pattern]);
+                position = candidate + m_patterns[pattern].pattern.length();
+            }
+        }
+    }
+
+    CASIMIR_EXPORT utilities::String utilities::StringReplacer::apply(const utilities::StringView& text) const {
+        // The result is at most as long as the text if no replacement is longer than its pattern, otherwise its
+        // exact length is computed by a first scan
+        cuint length = text.length();
+        if (!m_shrinking) {
+            forEachMatch(text, [&length](cuint, const Pattern& pattern) {
+                length = length - pattern.pattern.length() + pattern.replacement.length();
+            });
+        }
+
+        std::string output(length, '\0');
+        char* cursor = &output[0];
+        cuint copied = 0;
+        forEachMatch(text, [&](cuint position, const Pattern& pattern) {
+            memcpy(cursor, text.data() + copied, (size_t) (position - copied));
+            cursor += position - copied;
+            memcpy(cursor, pattern.replacement.c_str(), (size_t) pattern.replacement.length());
+            cursor += pattern.replacement.length();
+            copied = position + pattern.pattern.length();
+        });
+        memcpy(cursor, text.data() + copied, (size_t) (text.length() - copied));
+        cursor += text.length() - copied;
+        output.resize(cursor - output.data());
+        return String(std::move(output));
+    }
+
+    CASIMIR_EXPORT cuint utilities::StringReplacer::count(const utilities::StringView& text) const {
+        cuint count = 0;
+        forEachMatch(text, [&count](cuint, const Pattern&) { ++count; });
+        return count;
+    }
+
+}
@@ -0,0 +1,82 @@
+#ifndef CASIMIR_STRING_REPLACER_HPP_
+#define CASIMIR_STRING_REPLACER_HPP_
+
+#include <utility>
+#include <vector>
+
+#include "../casimir.hpp"
+#include "string.hpp"
+#include "string_view.hpp"
+
+namespace Casimir {
+
+    namespace utilities {
+
+        /**
+         * @brief Replace several patterns at once in a single pass over the text. The patterns are bucketed by their
+         * first byte. The text is scanned once by blocks for the positions where a pattern may start (according to the
+         * first two bytes of the patterns) and only the patterns starting with the byte found there are compared. The
+         * result is written into a buffer sized beforehand.
+         * At a given position the longest matching pattern wins, and the scan resumes after the replaced occurrence
+         * (replacements are never rescanned)
+         * @note Build the StringReplacer once to apply the same replacements to many texts (sanitization of logs or
+         * identifiers, ...). Applying it is thread-safe
+         * @code
+         * static const StringReplacer separators({{"{", ""}, {"}", ""}, {"-", ""}});
+         * String digits = separators.apply(text);
+         * @endcode
+         */
+        class StringReplacer {
+        private:
+            struct Pattern {
+                String pattern;
+                String replacement;
+            };
+
+            std::vector<Pattern> m_patterns;     // Sorted by first byte, the longest first
+            cuint m_buckets[257];                // Patterns starting with `b` are [m_buckets[b], m_buckets[b+1])
+            bool m_singleBytes;                  // Every pattern is a single byte (one candidate per byte)
+            bool m_shrinking;                    // No replacement is longer than its pattern
+            ubyte m_firstBytes[32];              // Tables of the first and second bytes of the patterns, laid out as
+            ubyte m_secondBytes[32];             // kernels::ByteSet (every byte is a second byte of a single byte)
+
+            /**
+             * @brief Find the pattern occurring at `position` of `text`
+             * @return the index of the pattern, m_patterns.size() if none occurs there
+             */
+            inline cuint match(const StringView& text, cuint position) const;
+
+            /**
+             * @brief Call `function(position, pattern)` for each occurrence replaced in `text`, from left to right
+             */
+            template<typename Function>
+            void forEachMatch(const StringView& text, Function&& function) const;
+
+        public:
+            /**
+             * @brief Compile the list of replacements (the empty patterns are ignored)
+             * @param replacements pairs (pattern, replacement). If a pattern is listed twice only its first
+             * replacement is used
+             */
+            CASIMIR_EXPORT explicit StringReplacer(const std::vector<std::pair<StringView, StringView>>& replacements);
+
+            /**
+             * @brief Replace every occurrence of the patterns in `text`
+             * @param text the text where the patterns are replaced
+             * @return The resulting String
+             */
+            CASIMIR_EXPORT String apply(const StringView& text) const;
+
+            /**
+             * @brief Count the occurrences of the patterns in `text` (the ones that `apply` would replace)
+             * @param text the text where the patterns are searched
+             * @return The number of occurrences
+             */
+            CASIMIR_EXPORT cuint count(const StringView& text) const;
+        };
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,336 @@
+#ifndef CASIMIR_STRING_VIEW_HPP_
+#define CASIMIR_STRING_VIEW_HPP_
+
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string>
+
+#include "../casimir.hpp"
+
+namespace Casimir {
+
+    namespace utilities {
+
+        class String;
+        class StringSplitter;
+
+        /**
+         * @brief Non-owning view over a sequence of characters (a utilities::String, a C-String or any buffer). Its
+         * search, compare and sub-string methods behave like the ones of utilities::String but never copy
+         * @warning The viewed characters must outlive the view (and all the views and tokens created from it)
+         */
+        class StringView {
+        private:
+            const char* m_data = "";
+            cuint m_length = 0;
+
+        public:
+            /**
+             * @brief Create a view over the empty string
+             */
+            inline StringView() = default;
+
+            /**
+             * @brief Create a view over a C-String
+             * @param str the null-terminated C-String to be viewed
+             */
+            inline StringView(const char* str)
+                : m_data(str), m_length((cuint) std::strlen(str))
+            {}
+
+            /**
+             * @brief Create a view over `length` bytes of `data`
+             * @param data the bytes to be viewed (may contain null bytes)
+             * @param length the number of bytes viewed
+             */
+            inline StringView(const char* data, cuint length)
+                : m_data(data), m_length(length)
+            {}
+
+            /**
+             * @brief Create a view over a std::string
+             * @param str the std::string to be viewed
+             */
+            inline StringView(const std::string& str)
+                : m_data(str.data()), m_length((cuint) str.length())
+            {}
+
+            /**
+             * @brief Return the first viewed character
+             * @warning The viewed characters aren't null-terminated in general
+             * @return a pointer to the viewed characters
+             */
+            inline const char* data() const {
+                return m_data;
+            }
+
+            /**
+             * @brief Get the number of viewed characters
+             * @return the length of the view
+             */
+            inline cuint length() const {
+                return m_length;
+            }
+
+            /**
+             * @brief Return whether or not the view is empty
+             * @return Whether or not no character is viewed
+             */
+            inline bool isEmpty() const {
+                return m_length == 0;
+            }
+
+            /**
+             * @brief Get character at position `pos`
+             * @param pos the character position
+             * @throw utilities::Exception if the position is out of the view
+             * @return A copy of the given character
+             */
+            CASIMIR_EXPORT char at(const cuint& pos) const;
+
+            /**
+             * @brief Get character at position `pos`
+             * @param pos the character position
+             * @return A copy of the given character
+             */
+            inline char operator[](const cuint& pos) const {
+                return at(pos);
+            }
+
+            /**
+             * @brief Same as <code>String::notFound()</code>
+             * @return a constant that defines the no found behavior
+             */
+            inline static constexpr cuint notFound() {
+                return std::numeric_limits<cuint>::max();
+            }
+
+            /**
+             * @brief Find the first occurrences of `research` from the position `afterPos`
+             * @param research The sub-string to find in the current view
+             * @param afterPos The position where we start the research
+             * @return The position of the first occurrence of `research` after the afterPos. If no occurrence is
+             * found return the <code>StringView::notFound()</code> constant
+             */
+            CASIMIR_EXPORT cuint findFirstOf(const StringView& research, const cuint& afterPos) const;
+
+            /**
+             * @brief Find the last occurrences of `research` before the position `beforePos`
+             * @param research The sub-string to find in the current view
+             * @param beforePos The position where we stop the research
+             * @throw utilities::Exception if `beforePos` is out of the view
+             * @return The position of the last occurrence of `research` ending at `beforePos` at the latest. If no
+             * occurrence is found return the <code>StringView::notFound()</code> constant
+             */
+            CASIMIR_EXPORT cuint findLastOf(const StringView& research, const cuint& beforePos) const;
+
+            /**
+             * @brief Find first occurrence of research
+             * @param research The sub-string to find in the current view
+             * @return The position of the first occurrence of `research`. If no occurrence is found return the
+             * <code>StringView::notFound()</code> constant
+             */
+            inline cuint findFirstOf(const StringView& research) const {
+                return findFirstOf(research, 0);
+            }
+
+            /**
+             * @brief Find last occurrence of research
+             * @param research The sub-string to find in the current view
+             * @return The position of the last occurrence of `research`. If no occurrence is found return the
+             * <code>StringView::notFound()</code> constant
+             */
+            inline cuint findLastOf(const StringView& research) const {
+                return findLastOf(research, length() - 1);
+            }
+
+            /**
+             * @brief Find the first character that isn't an hexadecimal digit (either case)
+             * @return The position of the first non-hexadecimal character. If all the characters are hexadecimal
+             * digits return the <code>StringView::notFound()</code> constant
+             */
+            CASIMIR_EXPORT cuint findFirstNotHex() const;
+
+            /**
+             * @brief Return whether or not all the viewed characters are ASCII characters (below 0x80)
+             * @return the result of the above check
+             */
+            CASIMIR_EXPORT bool isAscii() const;
+
+            /**
+             * @brief Count the occurrences of the character `value`
+             * @param value the character to be counted
+             * @return The number of occurrences of `value`
+             */
+            CASIMIR_EXPORT cuint count(char value) const;
+
+            /**
+             * @brief View the sub-string that start at position `start` and has length `length` (nothing is copied)
+             * @param start the starting position of the sub-string we are considering
+             * @param length the length of the sub-string we are considering
+             * @throw utilities::Exception if the sub-string isn't contained in the current view
+             * @return the view of the sub-string
+             */
+            CASIMIR_EXPORT StringView substr(const cuint& start, const cuint& length) const;
+
+            /**
+             * @brief Check if the view start with the given `str`
+             * @param str the `str` to use for the check
+             * @return Whether or not the view start with the given sequence
+             */
+            inline bool startsWith(const StringView& str) const {
+                return str.m_length <= m_length && std::memcmp(m_data, str.m_data, (size_t) str.m_length) == 0;
+            }
+
+            /**
+             * @brief Check if the view end with the given `str`
+             * @param str the `str` to use for the check
+             * @return Whether or not the view end with the given sequence
+             */
+            inline bool endsWith(const StringView& str) const {
+                return str.m_length <= m_length &&
+                       std::memcmp(m_data + m_length - str.m_length, str.m_data, (size_t) str.m_length) == 0;
+            }
+
+            /**
+             * @brief Equality operator between two views
+             * @param str The second view we are comparing to
+             * @return Whether or not the two views contain the same characters
+             */
+            inline bool operator==(const StringView& str) const {
+                return m_length == str.m_length && std::memcmp(m_data, str.m_data, (size_t) m_length) == 0;
+            }
+
+            /**
+             * @brief Non-equality operator between two views
+             * @param str The second view we are comparing to
+             * @return Whether or not the two views contain different characters
+             */
+            inline bool operator!=(const StringView& str) const {
+                return !(*this == str);
+            }
+
+            /**
+             * @brief Lazily split the view over a given separator token (see StringSplitter)
+             * @param separator The separator token (the view is split on each occurrence of this argument)
+             * @param discardEmptyStrings If set to true, the empty tokens are skipped
+             * @return A StringSplitter yielding the tokens as views of the current one
+             */
+            inline StringSplitter split(const StringView& separator, bool discardEmptyStrings = false) const;
+
+            /**
+             * @brief Copy the viewed characters to a String
+             * @return the resulting String
+             */
+            CASIMIR_EXPORT String toString() const;
+        };
+
+        /**
+         * @brief Lazy tokenizer splitting a StringView on each occurrence of a separator. The tokens are views of the
+         * split one and are only searched when requested, so that tokenizing doesn't allocate. It follows the
+         * behavior of <code>String::split</code>: the empty token after a trailing separator isn't yielded and an
+         * empty view yields a single empty token (unless the empty tokens are discarded)
+         * @code
+         * for (StringView token : StringView(text).split(",")) { ... }
+         * @endcode
+         */
+        class StringSplitter {
+        private:
+            StringView m_text;
+            StringView m_separator;
+            bool m_discardEmptyStrings;
+            cuint m_position = 0;
+
+        public:
+            /**
+             * @brief Input iterator over the remaining tokens of a StringSplitter
+             */
+            class Iterator {
+            private:
+                StringSplitter* m_splitter;
+                StringView m_token;
+
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = StringView;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const StringView*;
+                using reference = const StringView&;
+
+                /**
+                 * @brief Create an iterator reading the tokens of `splitter` (the end iterator if nullptr)
+                 * @param splitter the splitter the tokens are read from
+                 */
+                inline explicit Iterator(StringSplitter* splitter)
+                    : m_splitter(splitter)
+                {
+                    ++(*this);
+                }
+
+                inline reference operator*() const {
+                    return m_token;
+                }
+
+                inline pointer operator->() const {
+                    return &m_token;
+                }
+
+                inline Iterator& operator++() {
+                    if (m_splitter != nullptr && !m_splitter->next(m_token)) m_splitter = nullptr;
+                    return *this;
+                }
+
+                inline bool operator==(const Iterator& other) const {
+                    return m_splitter == other.m_splitter;
+                }
+
+                inline bool operator!=(const Iterator& other) const {
+                    return m_splitter != other.m_splitter;
+                }
+            };
+
+            /**
+             * @brief Create a tokenizer of `text`
+             * @param text The view to be split
+             * @param separator The separator token (the view is split on each occurrence of this argument, an empty
+             * separator yields the whole view)
+             * @param discardEmptyStrings If set to true, the empty tokens are skipped
+             */
+            inline StringSplitter(const StringView& text, const StringView& separator, bool discardEmptyStrings = false)
+                : m_text(text), m_separator(separator), m_discardEmptyStrings(discardEmptyStrings)
+            {}
+
+            /**
+             * @brief Read the next token
+             * @param token set to the next token if there is one
+             * @return Whether or not a token has been read
+             */
+            CASIMIR_EXPORT bool next(StringView& token);
+
+            /**
+             * @brief Return an iterator reading the remaining tokens (the tokens are consumed by the iteration)
+             * @return the iterator on the next token
+             */
+            inline Iterator begin() {
+                return Iterator(this);
+            }
+
+            /**
+             * @brief Return the iterator past the last token
+             * @return the end iterator
+             */
+            inline Iterator end() {
+                return Iterator(nullptr);
+            }
+        };
+
+        inline StringSplitter StringView::split(const StringView& separator, bool discardEmptyStrings) const {
+            return StringSplitter(*this, separator, discardEmptyStrings);
+        }
+
+    }
+
+}
+
+#endif
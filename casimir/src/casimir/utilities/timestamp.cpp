@@ -0,0 +1,100 @@
+#include "timestamp.hpp"
+
+#include <ctime>
+#include <cstring>
+#include <cstdio>
+
+namespace Casimir {
+
+    CASIMIR_EXPORT utilities::TimestampCache::TimestampCache()
+        : m_sequence(0), m_second(std::numeric_limits<int64>::min()), m_length(0), m_suffixPosition(0)
+    {
+        for (auto& word : m_text) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    cuint utilities::TimestampCache::formatSecond(int64 second, char* buffer, cuint& suffixPosition) {
+        // Convert it to tm structure (reentrant versions only)
+        const time_t timePoint = (time_t) second;
+        tm now{};
+#ifdef _WIN32
+        gmtime_s(&now, &timePoint);
+#else
+        gmtime_r(&timePoint, &now);
+#endif
+
+        // The sub-second suffix is inserted right after the seconds
+        suffixPosition = (cuint) strftime(buffer, (size_t) maxLength(), "%Y-%m-%d at %H:%M:%S", &now);
+        return suffixPosition + (cuint) strftime(buffer + suffixPosition, (size_t) (maxLength() - suffixPosition),
+                                                 " [ UTC%z ]", &now);
+    }
+
+    CASIMIR_EXPORT cuint utilities::TimestampCache::formatInto(char* buffer,
+                                                               std::chrono::system_clock::time_point timePoint,
+                                                               TimestampPrecision precision) {
+        const auto sinceEpoch = std::chrono::duration_cast<std::chrono::microseconds>(timePoint.time_since_epoch());
+        int64 second = (int64) (sinceEpoch.count() / 1000000);
+        int64 microsecond = (int64) (sinceEpoch.count() % 1000000);
+        if (microsecond < 0) { // Time point before epoch
+            microsecond += 1000000;
+            --second;
+        }
+
+        // Try to read the cached second (the copy is discarded if a writer was active in the meantime)
+        char text[maxLength()];
+        static_assert(maxLength() == s_words * sizeof(uint64), "The cached text must hold a whole timestamp");
+        cuint length = 0, suffixPosition = 0;
+        bool hit = false;
+        const uint64 sequence = m_sequence.load(std::memory_order_acquire);
+        if ((sequence & 1U) == 0 && m_second.load(std::memory_order_relaxed) == second) {
+            length = (cuint) m_length.load(std::memory_order_relaxed);
+            suffixPosition = (cuint) m_suffixPosition.load(std::memory_order_relaxed);
+            for (cuint i = 0; i < s_words; ++i) {
+                const uint64 word = m_text[i].load(std::memory_order_relaxed);
+                memcpy(text + i * sizeof(uint64), &word, sizeof(uint64));
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            hit = m_sequence.load(std::memory_order_relaxed) == sequence;
+        }
+
+        if (!hit) {
+            length = formatSecond(second, text, suffixPosition);
+
+            // Publish the new second unless another thread is already doing it (never wait for it)
+            uint64 expected = m_sequence.load(std::memory_order_relaxed);
+            if ((expected & 1U) == 0 &&
+                m_sequence.compare_exchange_strong(expected, expected + 1, std::memory_order_acquire)) {
+                std::atomic_thread_fence(std::memory_order_release);
+                m_second.store(second, std::memory_order_relaxed);
+                m_length.store(length, std::memory_order_relaxed);
+                m_suffixPosition.store(suffixPosition, std::memory_order_relaxed);
+                for (cuint i = 0; i < s_words; ++i) {
+                    uint64 word;
+                    memcpy(&word, text + i * sizeof(uint64), sizeof(uint64));
+                    m_text[i].store(word, std::memory_order_relaxed);
+                }
+                m_sequence.store(expected + 2, std::memory_order_release);
+            }
+        }
+
+        // Write the result with the sub-second suffix if any
+        memcpy(buffer, text, (size_t) suffixPosition);
+        cuint position = suffixPosition;
+        if (precision == TimestampPrecision::Millisecond) {
+            position += (cuint) snprintf(buffer + position, 5, ".%03d", (int) (microsecond / 1000));
+        } else if (precision == TimestampPrecision::Microsecond) {
+            position += (cuint) snprintf(buffer + position, 8, ".%06d", (int) microsecond);
+        }
+        memcpy(buffer + position, text + suffixPosition, (size_t) (length - suffixPosition));
+        return position + length - suffixPosition;
+    }
+
+    CASIMIR_EXPORT utilities::String utilities::TimestampCache::format(std::chrono::system_clock::time_point timePoint,
+                                                                       TimestampPrecision precision) {
+        char buffer[maxLength()];
+        const cuint length = formatInto(buffer, timePoint, precision);
+        return String(buffer, length);
+    }
+
+}
@@ -0,0 +1,95 @@
+#ifndef CASIMIR_TIMESTAMP_HPP_
+#define CASIMIR_TIMESTAMP_HPP_
+
+#include <atomic>
+#include <chrono>
+
+#include "../casimir.hpp"
+#include "string.hpp"
+
+namespace Casimir {
+
+    namespace utilities {
+
+        /**
+         * @brief Defines the sub-second suffix appended by the TimestampCache after the seconds
+         */
+        enum class TimestampPrecision {
+            Second,
+            Millisecond,
+            Microsecond
+        };
+
+        /**
+         * @brief Thread-safe formatter of UTC timestamps of format `YYYY-MM-DD at HH:MM:SS [ UTC+0000 ]`. The formatted
+         * second is cached and shared between threads without any lock (sequence lock) so that formatting a timestamp
+         * is only a copy as long as the second doesn't change
+         */
+        class TimestampCache {
+            CASIMIR_DISABLE_COPY_MOVE(TimestampCache);
+        private:
+            static constexpr cuint s_words = 8;
+
+            alignas(64) std::atomic<uint64> m_sequence;
+            std::atomic<int64> m_second;
+            std::atomic<uint64> m_length;
+            std::atomic<uint64> m_suffixPosition;
+            std::atomic<uint64> m_text[s_words];
+
+            /**
+             * @brief Format a second since epoch without the cache
+             * @param second the number of seconds since epoch
+             * @param buffer the output buffer (at least maxLength() bytes)
+             * @param suffixPosition the position where a sub-second suffix must be inserted
+             * @return the length of the formatted timestamp
+             */
+            static cuint formatSecond(int64 second, char* buffer, cuint& suffixPosition);
+
+        public:
+            /**
+             * @brief Default constructor of an empty TimestampCache
+             */
+            CASIMIR_EXPORT TimestampCache();
+
+            /**
+             * @brief The maximum number of bytes written by TimestampCache::formatInto
+             * @return the maximum length of a formatted timestamp
+             */
+            inline static constexpr cuint maxLength() {
+                return 64;
+            }
+
+            /**
+             * @brief Format a time point into a buffer
+             * @param buffer the output buffer that must hold at least maxLength() bytes (not null-terminated)
+             * @param timePoint the time point to be formatted
+             * @param precision the sub-second suffix appended after the seconds
+             * @return the number of bytes written into the buffer
+             */
+            CASIMIR_EXPORT cuint formatInto(char* buffer, std::chrono::system_clock::time_point timePoint,
+                                            TimestampPrecision precision = TimestampPrecision::Second);
+
+            /**
+             * @brief Format a time point into a String
+             * @param timePoint the time point to be formatted
+             * @param precision the sub-second suffix appended after the seconds
+             * @return the resulting formatted String
+             */
+            CASIMIR_EXPORT String format(std::chrono::system_clock::time_point timePoint,
+                                         TimestampPrecision precision = TimestampPrecision::Second);
+
+            /**
+             * @brief Format the current time into a String
+             * @param precision the sub-second suffix appended after the seconds
+             * @return the resulting formatted String
+             */
+            inline String now(TimestampPrecision precision = TimestampPrecision::Second) {
+                return format(std::chrono::system_clock::now(), precision);
+            }
+        };
+
+    }
+
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "uuid.hpp"
+#include "string_replacer.hpp"
 
 #include <cstring>
 
@@ -28,11 +29,9 @@ namespace Casimir {
     }
 
     CASIMIR_EXPORT utilities::Optional<utilities::Uuid> utilities::Uuid::fromParsedString(const utilities::String &parsedString) {
-        String rawHexString = parsedString
-                .replaceAll("{", "")
-                .replaceAll("}", "")
-                .replaceAll("-", "")
-                .decodeFromHex();
+        // Keep the hexadecimal digits only (the braces and dashes are skipped wherever they are)
+        static const StringReplacer separators({{"{", ""}, {"}", ""}, {"-", ""}});
+        String rawHexString = separators.apply(parsedString).decodeFromHex();
 
         // Return the Uuid using the raw string constructor
         return fromRawString(rawHexString);
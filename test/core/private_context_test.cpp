@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include <casimir/core/private-context.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+static const String Time = "2023-11-14 at 22:13:20 [ UTC+0000 ]";
+
+TEST(PrivateContext, FormattedParserSingleLine) {
+	EXPECT_TRUE(formattedParser("Hello world", "INFO", Time) ==
+		"[ 2023-11-14 at 22:13:20 [ UTC+0000 ] ]    INFO : Hello world\n");
+	EXPECT_TRUE(formattedParser("", "ERROR", Time) ==
+		"[ 2023-11-14 at 22:13:20 [ UTC+0000 ] ]   ERROR : ");
+}
+
+TEST(PrivateContext, FormattedParserWrap) {
+	const String continuation = "\n" + String(' ', 48) + "| ";
+
+	// Space wrap pads the line to the full width
+	EXPECT_TRUE(formattedParser("aaaaaaaaaa bbbbbbbbbb cccccccccc dddddddddd eeeeeeeeee ffffffffff gg", "INFO", Time) ==
+		"[ 2023-11-14 at 22:13:20 [ UTC+0000 ] ]    INFO : aaaaaaaaaa bbbbbbbbbb cccccccccc dddddddddd eeeeeeeeee " +
+		String(' ', 5) + continuation + "ffffffffff gg\n");
+
+	// Word wrap cuts the word with an hyphen
+	EXPECT_TRUE(formattedParser(String('x', 70), "INFO", Time) ==
+		"[ 2023-11-14 at 22:13:20 [ UTC+0000 ] ]    INFO : " + String('x', 59) + "-" + continuation + String('x', 11) + "\n");
+
+	// A word longer than a line right after a space wrap is word-wrapped
+	const String output = formattedParser(String('a', 40) + " " + String('b', 70) + " c", "INFO", Time);
+	EXPECT_TRUE(output.startsWith("[ 2023-11-14 at 22:13:20 [ UTC+0000 ] ]    INFO : " + String('a', 40) + " "));
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/binary_logger.hpp>
+#include <casimir/utilities/exception.hpp>
+#include <casimir/core/private-context.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+TEST(BinaryLogger, RoundTrip) {
+	const char* filepath = "casimir_binary_logger_test.bin";
+	std::remove(filepath);
+	const int value = 0;
+	const void* pointer = &value;
+	const int64 before = BinaryLogCodec::now();
+	{
+		BinaryLogger logger(filepath);
+		logger.record(PrivateLogging::Info) << "answer " << (cint) -42 << " " << (cuint) 7 << " " << 1.5 << " " << pointer;
+		logger.logFrom(PrivateLogging::Error, "plain message");
+	}
+	{
+		// A second session appends a new header to the same file
+		BinaryLogger logger(filepath);
+		logger.log("nil channel");
+	}
+
+	BinaryLogReader reader(filepath);
+	BinaryLogEntry entry;
+	ASSERT_TRUE(reader.next(entry));
+	EXPECT_TRUE(entry.channel == PrivateLogging::Info);
+	EXPECT_GE(entry.timestamp, before);
+	EXPECT_TRUE(entry.message == "answer -42 7 " + String::toString(1.5) + " " + String((char*) &pointer, sizeof(void*)).encodeToHex());
+
+	ASSERT_TRUE(reader.next(entry));
+	EXPECT_TRUE(entry.channel == PrivateLogging::Error);
+	EXPECT_TRUE(entry.message == "plain message");
+	EXPECT_TRUE(formattedChannelMessage(entry.message, entry.channel, "T") == formattedParser("plain message", "ERROR", "T"));
+
+	ASSERT_TRUE(reader.next(entry));
+	EXPECT_TRUE(entry.channel.isNIL());
+	EXPECT_TRUE(entry.message == "nil channel");
+	EXPECT_FALSE(reader.next(entry));
+	std::remove(filepath);
+}
+
+TEST(BinaryLogger, RawMessageThroughLogger) {
+	const char* filepath = "casimir_binary_logger_raw_test.bin";
+	std::remove(filepath);
+	const int value = 0;
+	const void* pointer = &value;
+	String expected;
+	{
+		std::shared_ptr<BinaryLogger> binaryLogger = std::make_shared<BinaryLogger>(filepath);
+		Logger logger = LoggerBuilder()
+			.registerChannelAt(PrivateLogging::Warning, binaryLogger, [](const String& msg) { return "parsed " + msg; })
+			.create();
+		logger(PrivateLogging::Warning) << "raw " << (cint) -123456 << " " << (cuint) 7 << " " << 0.25f << " " << 1.5 << " " << pointer;
+
+		LoggerArguments arguments;
+		arguments.appendText("raw ", 4);
+		arguments.appendInteger(-123456);
+		arguments.appendText(" ", 1);
+		arguments.appendUnsigned(7);
+		arguments.appendText(" ", 1);
+		arguments.appendFloat(0.25f);
+		arguments.appendText(" ", 1);
+		arguments.appendDouble(1.5);
+		arguments.appendText(" ", 1);
+		arguments.appendPointer(pointer);
+		expected = arguments.render();
+	}
+
+	// The arguments are stored with their own type (the numbers aren't formatted) and bypass the parser
+	std::ifstream file(filepath, std::ios_base::in | std::ios_base::binary);
+	const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	EXPECT_EQ(bytes.find("-123456"), std::string::npos);
+
+	BinaryLogReader reader(filepath);
+	BinaryLogEntry entry;
+	ASSERT_TRUE(reader.next(entry));
+	EXPECT_TRUE(entry.channel == PrivateLogging::Warning);
+	EXPECT_TRUE(entry.message == expected);
+	EXPECT_FALSE(reader.next(entry));
+	std::remove(filepath);
+}
+
+TEST(BinaryLogger, CorruptRecordSize) {
+	const char* filepath = "casimir_binary_logger_corrupt_test.bin";
+	for (std::uint32_t size : {0x80000000U, 0xFFFFFFF0U, 100U, 8U}) {
+		std::remove(filepath);
+		{
+			BinaryLogger logger(filepath);
+			logger.log("valid");
+		}
+		{
+			// A record whose size doesn't match the rest of the file
+			std::ofstream file(filepath, std::ios_base::out | std::ios_base::binary | std::ios_base::app);
+			file.write((const char*) &size, sizeof(size));
+			file.write("0123456789abcdef0123456789abcdef", 32);
+		}
+
+		BinaryLogReader reader(filepath);
+		BinaryLogEntry entry;
+		ASSERT_TRUE(reader.next(entry));
+		EXPECT_TRUE(entry.message == "valid");
+
+		// Rejected before anything is allocated for the record
+		try {
+			reader.next(entry);
+			ADD_FAILURE() << "The corrupt record has been read";
+		} catch (const Exception& exception) {
+			EXPECT_NE(std::string(exception.what()).find("InvalidFormat"), std::string::npos);
+		}
+	}
+	std::remove(filepath);
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/cmutex.hpp>
+#include <casimir/utilities/exception.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+TEST(Mutex, Ownership) {
+	Mutex mutex;
+	EXPECT_FALSE(mutex.ownLock());
+	EXPECT_THROW(mutex.releaseLock(), Exception);
+
+	mutex.acquireLock();
+	EXPECT_TRUE(mutex.ownLock());
+	EXPECT_TRUE(mutex.tryAquireLock());
+	std::thread([&mutex]() {
+		EXPECT_FALSE(mutex.ownLock());
+		EXPECT_FALSE(mutex.tryAquireLock());
+		EXPECT_FALSE(mutex.tryAcquireLockFor(std::chrono::milliseconds(5)));
+		EXPECT_THROW(mutex.releaseLock(), Exception);
+	}).join();
+	mutex.releaseLock();
+	EXPECT_FALSE(mutex.ownLock());
+
+	std::thread([&mutex]() {
+		EXPECT_TRUE(mutex.tryAcquireLockFor(std::chrono::milliseconds(5)));
+		mutex.releaseLock();
+	}).join();
+}
+
+TEST(Mutex, TimedAcquireWaitsForRelease) {
+	Mutex mutex;
+	mutex.acquireLock();
+	std::thread waiter([&mutex]() {
+		EXPECT_TRUE(mutex.tryAcquireLockFor(std::chrono::seconds(10)));
+		mutex.releaseLock();
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	mutex.releaseLock();
+	waiter.join();
+}
+
+TEST(Mutex, MutualExclusion) {
+	Mutex mutex;
+	const cint threadCount = 8;
+	const cint iterationCount = 20000;
+	cint counter = 0;
+	std::vector<std::thread> threads;
+	for (cint t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&]() {
+			for (cint i = 0; i < iterationCount; ++i) {
+				if (i % 100 == 0 && mutex.tryAcquireLockFor(std::chrono::microseconds(50))) {
+					++counter;
+					mutex.releaseLock();
+					continue;
+				}
+				mutex.acquireLock();
+				++counter;
+				mutex.releaseLock();
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+	EXPECT_EQ(counter, threadCount * iterationCount);
+}
+
+TEST(Mutex, FifoOrder) {
+	Mutex mutex;
+	std::vector<cint> order;
+	mutex.acquireLock();
+
+	// Each thread takes its ticket once the previous one is already waiting
+	std::vector<std::thread> threads;
+	for (cint t = 0; t < 4; ++t) {
+		threads.emplace_back([&mutex, &order, t]() {
+			mutex.acquireLock();
+			order.push_back(t);
+			mutex.releaseLock();
+		});
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+	mutex.releaseLock();
+	for (auto& thread : threads) thread.join();
+	EXPECT_EQ(order, std::vector<cint>({0, 1, 2, 3}));
+}
+
+static LockContention findContention(const String& name) {
+	for (const LockContention& contention : LockProfiler::snapshot()) {
+		if (contention.name == name) return contention;
+	}
+	ADD_FAILURE() << "No profiled lock named " << name.c_str();
+	return LockContention();
+}
+
+TEST(Mutex, Profiling) {
+	ASSERT_TRUE(LockProfiler::isEnabled());
+	{
+		Mutex mutex("ProfiledTestMutex");
+		mutex.acquireLock();
+		std::thread thread([&mutex]() {
+			mutex.acquireLock();
+			mutex.releaseLock();
+		});
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		mutex.releaseLock();
+		thread.join();
+		EXPECT_TRUE(mutex.tryAquireLock());
+		mutex.releaseLock();
+
+		const LockContention contention = findContention("ProfiledTestMutex");
+		EXPECT_EQ(contention.acquisitions, 3);
+		EXPECT_EQ(contention.contendedAcquisitions, 1);
+		EXPECT_GE(contention.maxWait, std::chrono::milliseconds(10));
+		EXPECT_EQ(contention.totalWait, contention.maxWait);
+		EXPECT_GE(contention.maxHold, std::chrono::milliseconds(10));
+
+		// The waiting thread is the hottest call site
+		EXPECT_NE(contention.hottestSite.findFirstOf("cmutex_test.cpp:"), String::notFound());
+
+		// Nothing is recorded while the profiler is disabled
+		LockProfiler::setEnabled(false);
+		mutex.acquireLock();
+		mutex.releaseLock();
+		LockProfiler::setEnabled(true);
+		EXPECT_EQ(findContention("ProfiledTestMutex").acquisitions, 3);
+	}
+
+	// The statistics go away with the Mutex
+	for (const LockContention& contention : LockProfiler::snapshot()) {
+		EXPECT_FALSE(contention.name == "ProfiledTestMutex");
+	}
+}
+
+TEST(SharedMutex, ReadersShareWritersExclude) {
+	SharedMutex mutex;
+	mutex.acquireSharedLock();
+	std::thread([&mutex]() {
+		EXPECT_TRUE(mutex.tryAcquireSharedLock());
+		mutex.releaseSharedLock();
+		EXPECT_THROW(mutex.releaseLock(), Exception);
+	}).join();
+	mutex.releaseSharedLock();
+
+	mutex.acquireLock();
+	std::thread([&mutex]() {
+		EXPECT_FALSE(mutex.tryAcquireSharedLock());
+	}).join();
+	mutex.releaseLock();
+	EXPECT_TRUE(mutex.tryAcquireSharedLock());
+	mutex.releaseSharedLock();
+}
+
+TEST(SharedMutex, Consistency) {
+	SharedMutex mutex;
+	const cint readerCount = 6;
+	const cint writerCount = 2;
+	const cint iterationCount = 5000;
+	cint first = 0, second = 0;
+	std::atomic<cint> inconsistent(0);
+	std::vector<std::thread> threads;
+	for (cint t = 0; t < readerCount; ++t) {
+		threads.emplace_back([&]() {
+			for (cint i = 0; i < iterationCount; ++i) {
+				mutex.acquireSharedLock();
+				if (first != second) ++inconsistent;
+				mutex.releaseSharedLock();
+			}
+		});
+	}
+	for (cint t = 0; t < writerCount; ++t) {
+		threads.emplace_back([&]() {
+			for (cint i = 0; i < iterationCount / 10; ++i) {
+				mutex.acquireLock();
+				++first;
+				std::this_thread::yield();
+				++second;
+				mutex.releaseLock();
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+	EXPECT_EQ(inconsistent.load(), 0);
+	EXPECT_EQ(first, writerCount * (iterationCount / 10));
+	EXPECT_EQ(second, first);
+}
+
+TEST(SharedMutex, WriterSleepsUntilReadersLeave) {
+	SharedMutex mutex;
+	std::atomic<bool> released(false);
+	mutex.acquireSharedLock();
+	std::thread writer([&]() {
+		mutex.acquireLock();
+		EXPECT_TRUE(released.load());
+		mutex.releaseLock();
+	});
+	// Long enough for the writer to give up spinning and park
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	released.store(true);
+	mutex.releaseSharedLock();
+	writer.join();
+	EXPECT_TRUE(mutex.tryAcquireSharedLock());
+	mutex.releaseSharedLock();
+}
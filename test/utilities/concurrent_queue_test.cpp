@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/concurrent_queue.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+TEST(ConcurrentQueue, FifoAndCapacity) {
+	EXPECT_THROW(ConcurrentQueue<cuint>(0), Exception);
+
+	ConcurrentQueue<cuint> queue(5);
+	EXPECT_EQ(queue.capacity(), 8);
+	EXPECT_TRUE(queue.isEmpty());
+	for (cuint i = 0; i < 8; ++i) EXPECT_TRUE(queue.tryPush(i));
+	EXPECT_FALSE(queue.tryPush(8));
+	EXPECT_EQ(queue.size(), 8);
+
+	// The slots are reused on the next lap
+	cuint value;
+	for (cuint lap = 0; lap < 3; ++lap) {
+		for (cuint i = 0; i < 8; ++i) {
+			ASSERT_TRUE(queue.tryPop(value));
+			EXPECT_EQ(value, lap * 8 + i);
+			EXPECT_TRUE(queue.tryPush((lap + 1) * 8 + i));
+		}
+	}
+	EXPECT_EQ(queue.size(), 8);
+	while (queue.tryPop(value)) {}
+	EXPECT_TRUE(queue.isEmpty());
+	EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(ConcurrentQueue, Batch) {
+	ConcurrentQueue<cuint> queue(8);
+	std::vector<cuint> values = {0, 1, 2, 3, 4, 5};
+	EXPECT_EQ(queue.tryPushBatch(values.data(), 6), 6);
+
+	// Only the free slots are claimed
+	std::vector<cuint> more = {6, 7, 8, 9};
+	EXPECT_EQ(queue.tryPushBatch(more.data(), 4), 2);
+	EXPECT_EQ(queue.tryPushBatch(more.data() + 2, 2), 0);
+
+	std::vector<cuint> popped(16);
+	EXPECT_EQ(queue.tryPopBatch(popped.data(), 3), 3);
+	EXPECT_EQ(queue.tryPopBatch(popped.data() + 3, 16), 5);
+	EXPECT_EQ(queue.tryPopBatch(popped.data(), 16), 0);
+	for (cuint i = 0; i < 8; ++i) EXPECT_EQ(popped[i], i);
+}
+
+TEST(ConcurrentQueue, MoveOnlyElements) {
+	std::shared_ptr<int> tracked = std::make_shared<int>(42);
+	{
+		ConcurrentQueue<std::unique_ptr<std::shared_ptr<int>>> queue(4);
+		EXPECT_TRUE(queue.tryEmplace(new std::shared_ptr<int>(tracked)));
+		EXPECT_TRUE(queue.tryEmplace(new std::shared_ptr<int>(tracked)));
+		EXPECT_EQ(**queue.pop(), 42);
+		EXPECT_EQ(tracked.use_count(), 2);
+	}
+
+	// The elements left in the queue are destroyed with it
+	EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(ConcurrentQueue, BlockingWaitsForTheOtherSide) {
+	ConcurrentQueue<cuint> queue(2);
+	cuint value;
+	EXPECT_FALSE(queue.tryPopFor(value, std::chrono::milliseconds(10)));
+
+	std::thread consumer([&queue]() {
+		for (cuint i = 0; i < 100; ++i) EXPECT_EQ(queue.pop(), i);
+	});
+	for (cuint i = 0; i < 100; ++i) queue.push(i);
+	consumer.join();
+
+	EXPECT_TRUE(queue.tryPushFor(0, std::chrono::milliseconds(10)));
+	EXPECT_TRUE(queue.tryPushFor(1, std::chrono::milliseconds(10)));
+	EXPECT_FALSE(queue.tryPushFor(2, std::chrono::milliseconds(10)));
+}
+
+TEST(ConcurrentQueue, Stress) {
+	const cuint producers = 4;
+	const cuint consumers = 4;
+	const cuint count = 50000;
+	ConcurrentQueue<cuint> queue(64);
+	std::atomic<cuint> sum(0);
+	std::atomic<cuint> popped(0);
+	std::vector<std::thread> threads;
+
+	// Every element is seen exactly once and each producer's elements come out in order
+	std::vector<std::vector<cuint>> lastSeen(consumers, std::vector<cuint>(producers, 0));
+	for (cuint p = 0; p < producers; ++p) {
+		threads.emplace_back([&queue, p]() {
+			std::vector<cuint> batch;
+			const auto flush = [&queue, &batch]() {
+				cuint pushed = 0;
+				while (pushed < batch.size()) {
+					pushed += queue.tryPushBatch(batch.data() + pushed, batch.size() - pushed);
+					if (pushed < batch.size()) std::this_thread::yield();
+				}
+				batch.clear();
+			};
+			for (cuint i = 1; i <= count; ++i) {
+				const cuint value = p * count + i;
+				if (i % 7 == 0) {
+					flush();
+					queue.push(value);
+					continue;
+				}
+				batch.push_back(value);
+				if (batch.size() == 4 || i == count) flush();
+			}
+		});
+	}
+	for (cuint c = 0; c < consumers; ++c) {
+		threads.emplace_back([&, c]() {
+			cuint values[8];
+			while (popped.load() < producers * count) {
+				const cuint received = c % 2 == 0 ? queue.tryPopBatch(values, 8) :
+					(queue.tryPopFor(values[0], std::chrono::milliseconds(1)) ? 1 : 0);
+				for (cuint i = 0; i < received; ++i) {
+					const cuint producer = (values[i] - 1) / count;
+					const cuint index = (values[i] - 1) % count + 1;
+					EXPECT_GT(index, lastSeen[c][producer]);
+					lastSeen[c][producer] = index;
+					sum.fetch_add(values[i]);
+				}
+				popped.fetch_add(received);
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	const cuint total = producers * count;
+	EXPECT_EQ(popped.load(), total);
+	EXPECT_EQ(sum.load(), total * (total + 1) / 2);
+	EXPECT_TRUE(queue.isEmpty());
+}
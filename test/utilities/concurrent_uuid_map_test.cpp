@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/concurrent_uuid_map.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+TEST(ConcurrentUuidMap, InsertFindErase) {
+	EXPECT_THROW(ConcurrentUuidMap<cuint>(0), Exception);
+
+	ConcurrentUuidMap<String> map(4);
+	UuidCounterGenerator generator;
+	std::vector<Uuid> keys;
+	for (cuint i = 0; i < 1000; ++i) keys.push_back(generator.nextUuid());
+	for (cuint i = 0; i < keys.size(); ++i) EXPECT_TRUE(map.insert(keys[i], std::to_string(i)));
+	EXPECT_EQ(map.size(), 1000);
+	EXPECT_FALSE(map.insert(keys[0], "again"));
+
+	String value;
+	for (cuint i = 0; i < keys.size(); ++i) {
+		ASSERT_TRUE(map.find(keys[i], value));
+		EXPECT_TRUE(value == std::to_string(i));
+	}
+	EXPECT_FALSE(map.find(generator.nextUuid(), value));
+	EXPECT_FALSE(map.contains(Uuid()));
+
+	map.insertOrAssign(keys[0], "zero");
+	EXPECT_TRUE(map.visit(keys[0], [](const String& found) { EXPECT_TRUE(found == "zero"); }));
+	EXPECT_EQ(map.size(), 1000);
+
+	// The erased buckets are reused
+	for (cuint i = 0; i < keys.size(); i += 2) EXPECT_TRUE(map.erase(keys[i]));
+	EXPECT_FALSE(map.erase(keys[0]));
+	EXPECT_EQ(map.size(), 500);
+	for (cuint i = 0; i < keys.size(); ++i) EXPECT_EQ(map.contains(keys[i]), i % 2 == 1);
+	for (cuint i = 0; i < keys.size(); i += 2) EXPECT_TRUE(map.insert(keys[i], "back"));
+	EXPECT_EQ(map.size(), 1000);
+}
+
+TEST(ConcurrentUuidMap, ValuesAreDestroyed) {
+	std::shared_ptr<int> tracked = std::make_shared<int>(0);
+	{
+		ConcurrentUuidMap<std::shared_ptr<int>> map;
+		map.insert(Uuid(1, 1), tracked);
+		map.insert(Uuid(1, 2), tracked);
+		map.insertOrAssign(Uuid(1, 1), tracked);
+		map.erase(Uuid(1, 2));
+		EXPECT_EQ(tracked.use_count(), 2);
+	}
+	EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(ConcurrentUuidMap, ConcurrentReadersAndWriters) {
+	const cuint writers = 4;
+	const cuint readers = 4;
+	const cuint count = 5000;
+	ConcurrentUuidMap<cuint> map(8);
+	std::atomic<bool> done(false);
+	std::vector<std::thread> threads;
+
+	// A stable key never disappears while the other keys of its shard are written
+	for (cuint i = 0; i < 100; ++i) map.insert(Uuid(0, i), i);
+	for (cuint w = 0; w < writers; ++w) {
+		threads.emplace_back([&map, w]() {
+			for (cuint i = 0; i < count; ++i) {
+				const Uuid key(w + 1, i);
+				EXPECT_TRUE(map.insert(key, i));
+				map.insertOrAssign(key, i + 1);
+				if (i % 2 == 0) {
+					EXPECT_TRUE(map.erase(key));
+				}
+			}
+		});
+	}
+	for (cuint r = 0; r < readers; ++r) {
+		threads.emplace_back([&map, &done]() {
+			cuint value;
+			while (!done.load()) {
+				for (cuint i = 0; i < 100; ++i) {
+					ASSERT_TRUE(map.find(Uuid(0, i), value));
+					EXPECT_EQ(value, i);
+				}
+			}
+		});
+	}
+	for (cuint w = 0; w < writers; ++w) threads[w].join();
+	done.store(true);
+	for (cuint r = 0; r < readers; ++r) threads[writers + r].join();
+
+	EXPECT_EQ(map.size(), 100 + writers * count / 2);
+	cuint value;
+	for (cuint w = 0; w < writers; ++w) {
+		for (cuint i = 1; i < count; i += 2) {
+			ASSERT_TRUE(map.find(Uuid(w + 1, i), value));
+			EXPECT_EQ(value, i + 1);
+		}
+	}
+}
+
+TEST(ConcurrentUuidMap, RetiredValuesAreFreedUnderReads) {
+	std::shared_ptr<int> tracked = std::make_shared<int>(0);
+	ConcurrentUuidMap<std::shared_ptr<int>> map(1);
+	map.insert(Uuid(0, 0), tracked);
+	std::atomic<bool> done(false);
+
+	// The lookups never stop while the value is replaced
+	std::vector<std::thread> readers;
+	for (cuint r = 0; r < 2; ++r) {
+		readers.emplace_back([&map, &done]() {
+			while (!done.load()) {
+				EXPECT_TRUE(map.contains(Uuid(0, 0)));
+			}
+		});
+	}
+	for (cuint i = 0; i < 10000; ++i) map.insertOrAssign(Uuid(0, 0), tracked);
+	EXPECT_LT(tracked.use_count(), 1000);
+	done.store(true);
+	for (std::thread& reader : readers) reader.join();
+}
+
+TEST(ConcurrentUuidMap, LookupsDuringGrowth) {
+	ConcurrentUuidMap<cuint> map(4);
+	std::atomic<bool> done(false);
+	for (cuint i = 0; i < 50; ++i) map.insert(Uuid(0, i), i);
+
+	// The tables grow while other writers move the epoch with replacements and erasures
+	std::vector<std::thread> threads;
+	threads.emplace_back([&map]() {
+		for (cuint i = 0; i < 20000; ++i) EXPECT_TRUE(map.insert(Uuid(1, i), i));
+	});
+	threads.emplace_back([&map, &done]() {
+		for (cuint i = 0; !done.load(); ++i) {
+			map.insertOrAssign(Uuid(2, i % 64), i);
+			if (i % 3 == 0) map.erase(Uuid(2, (i / 3) % 64));
+		}
+	});
+	for (cuint r = 0; r < 2; ++r) {
+		threads.emplace_back([&map, &done]() {
+			cuint value;
+			while (!done.load()) {
+				for (cuint i = 0; i < 50; ++i) {
+					ASSERT_TRUE(map.find(Uuid(0, i), value));
+					EXPECT_EQ(value, i);
+				}
+			}
+		});
+	}
+	threads[0].join();
+	done.store(true);
+	for (cuint i = 1; i < threads.size(); ++i) threads[i].join();
+	EXPECT_GE(map.size(), 50 + 20000);
+	cuint value;
+	for (cuint i = 0; i < 20000; ++i) {
+		ASSERT_TRUE(map.find(Uuid(1, i), value));
+		EXPECT_EQ(value, i);
+	}
+}
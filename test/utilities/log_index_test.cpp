@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/log_index.hpp>
+#include <casimir/core/private-context.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+static void appendFile(const char* filepath, const String& text) {
+	std::ofstream stream(filepath, std::ios_base::out | std::ios_base::binary | std::ios_base::app);
+	stream.write(text.c_str(), (std::streamsize) text.length());
+}
+
+static int64 timestamp(const char* text) {
+	int64 value = 0;
+	EXPECT_NE(LogIndex::parseTimestamp(text, (cuint) strlen(text), value), 0);
+	return value;
+}
+
+TEST(LogIndex, ParseTimestamp) {
+	EXPECT_EQ(timestamp("1970-01-01 00:00:00"), 0);
+	EXPECT_EQ(timestamp("2001-09-09T01:46:40"), 1000000000LL * 1000000);
+	EXPECT_EQ(timestamp("2024-02-29 at 12:00:00.5 [ UTC+0000 ]"), 1709208000LL * 1000000 + 500000);
+
+	int64 value;
+	EXPECT_EQ(LogIndex::parseTimestamp("2024-13-01 00:00:00", 19, value), 0);
+	EXPECT_EQ(LogIndex::parseTimestamp("not a time", 10, value), 0);
+}
+
+TEST(LogIndex, QueryAndIncrementalUpdate) {
+	const char* filepath = "casimir_log_index_test.log";
+	const String indexPath = String(filepath) + ".idx";
+	std::remove(filepath);
+	std::remove(indexPath.c_str());
+
+	const String t1 = "2026-01-01 at 10:00:00 [ UTC+0000 ]";
+	const String t2 = "2026-01-01 at 10:00:05 [ UTC+0000 ]";
+	const String t3 = "2026-01-01 at 10:00:09 [ UTC+0000 ]";
+	const String longMessage = String('x', 150);
+	const String first = formattedParser("first", "INFO", t1);
+	const String error = formattedParser(longMessage, "ERROR", t2);
+	appendFile(filepath, first + "raw line\n" + error);
+	{
+		LogIndex index(filepath);
+		EXPECT_EQ(index.size(), 2);
+		const std::vector<LogIndexEntry> errors = index.query("ERROR");
+		ASSERT_EQ(errors.size(), 1);
+		EXPECT_TRUE(index.text(errors[0]) == error);
+		EXPECT_TRUE(index.channelName(errors[0]) == "ERROR");
+		EXPECT_EQ(index.query("", timestamp("2026-01-01 10:00:01"), timestamp("2026-01-01 10:00:06")).size(), 1);
+		EXPECT_EQ(index.query("WARN").size(), 0);
+
+		// Only the appended records are parsed
+		const String late = formattedParser("late", "ERROR", t3);
+		appendFile(filepath, late);
+		EXPECT_EQ(index.update(), 1);
+		EXPECT_EQ(index.query("ERROR", timestamp("2026-01-01 10:00:08")).size(), 1);
+		EXPECT_EQ(index.update(), 0);
+	}
+
+	// The index is read back from the sidecar file
+	appendFile(filepath, formattedParser("again", "INFO", t3));
+	LogIndex index(filepath);
+	EXPECT_EQ(index.size(), 4);
+	const std::vector<LogIndexEntry> infos = index.query("INFO");
+	ASSERT_EQ(infos.size(), 2);
+	EXPECT_TRUE(index.text(infos[0]) == first);
+	EXPECT_EQ(infos[1].timestamp, timestamp("2026-01-01 10:00:09"));
+
+	std::remove(filepath);
+	std::remove(indexPath.c_str());
+}
+
+TEST(LogIndex, ContinuationOfTheLastRecord) {
+	const char* filepath = "casimir_log_index_continuation_test.log";
+	const String indexPath = String(filepath) + ".idx";
+	std::remove(filepath);
+	std::remove(indexPath.c_str());
+
+	const String record = formattedParser(String('a', 100), "WARN", "2026-01-01 at 10:00:00 [ UTC+0000 ]");
+	const cuint firstLine = record.findFirstOf("\n") + 1;
+	ASSERT_LT(firstLine, record.length());
+	appendFile(filepath, record.substr(0, firstLine));
+	{
+		LogIndex index(filepath);
+		ASSERT_EQ(index.size(), 1);
+
+		// The continuation line written later still belongs to the record
+		appendFile(filepath, record.substr(firstLine, record.length() - firstLine));
+		EXPECT_EQ(index.update(), 0);
+		EXPECT_TRUE(index.text(index.query("WARN")[0]) == record);
+	}
+	LogIndex index(filepath);
+	ASSERT_EQ(index.size(), 1);
+	EXPECT_TRUE(index.text(index.query("WARN")[0]) == record);
+
+	std::remove(filepath);
+	std::remove(indexPath.c_str());
+}
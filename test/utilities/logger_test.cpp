@@ -0,0 +1,357 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/logger.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <fstream>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+class MemoryLogger : public AbstractLoggerChannel {
+public:
+	std::mutex mutex;
+	std::vector<String> messages;
+
+	void log(const String& msg) override {
+		std::lock_guard<std::mutex> lock(mutex);
+		messages.push_back(msg);
+	}
+};
+
+static const Uuid TestChannel = Uuid(1, 2);
+
+TEST(Logger, Synchronous) {
+	std::shared_ptr<MemoryLogger> memory = std::make_shared<MemoryLogger>();
+	Logger logger = LoggerBuilder()
+		.registerChannelAt(TestChannel, memory, [](const String& msg){ return "<" + msg + ">"; })
+		.create();
+
+	EXPECT_FALSE(logger.isAsynchronous());
+	logger(TestChannel) << "Hello " << (cint) 42;
+	logger(Uuid(3, 4)) << "Nobody listens";
+	ASSERT_EQ(memory->messages.size(), 1);
+	EXPECT_TRUE(memory->messages[0] == "<Hello 42>");
+}
+
+TEST(Logger, AsynchronousOrderAndFlush) {
+	std::shared_ptr<MemoryLogger> memory = std::make_shared<MemoryLogger>();
+	Logger logger = LoggerBuilder()
+		.registerChannelAt(TestChannel, memory, [](const String& msg){ return msg; })
+		.setAsynchronous(16, LoggerOverflowPolicy::Block)
+		.create();
+
+	EXPECT_TRUE(logger.isAsynchronous());
+	const cint producerCount = 4;
+	const cint messageCount = 1000;
+	std::vector<std::thread> producers;
+	for (cint p = 0; p < producerCount; ++p) {
+		producers.emplace_back([&logger, p]() {
+			for (cint i = 0; i < messageCount; ++i) {
+				logger(TestChannel) << p << ":" << i;
+			}
+		});
+	}
+	for (auto& producer : producers) producer.join();
+	logger.flush();
+
+	ASSERT_EQ(memory->messages.size(), (size_t) (producerCount * messageCount));
+	EXPECT_EQ(logger.droppedCount(), 0);
+
+	// Messages of a single producer keep their order
+	std::vector<cint> next(producerCount, 0);
+	for (const String& msg : memory->messages) {
+		const std::vector<String> parts = msg.split(":");
+		const cint p = std::stoll(parts[0].str());
+		EXPECT_EQ(std::stoll(parts[1].str()), next[p]);
+		++next[p];
+	}
+}
+
+TEST(Logger, AsynchronousDropAndCount) {
+	std::shared_ptr<MemoryLogger> memory = std::make_shared<MemoryLogger>();
+	Logger logger = LoggerBuilder()
+		.registerChannelAt(TestChannel, memory, [](const String& msg){ return msg; })
+		.setAsynchronous(4, LoggerOverflowPolicy::DropAndCount)
+		.create();
+
+	const cint messageCount = 10000;
+	for (cint i = 0; i < messageCount; ++i) {
+		logger(TestChannel) << i;
+	}
+	logger.flush();
+	EXPECT_EQ(memory->messages.size() + logger.droppedCount(), (size_t) messageCount);
+}
+
+static std::string readFile(const char* filepath) {
+	std::ifstream stream(filepath, std::ios_base::in | std::ios_base::binary);
+	return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+TEST(Logger, BufferedFileLogger) {
+	const char* filepath = "casimir_buffered_file_logger_test.log";
+	std::remove(filepath);
+	{
+		FileLogger fileLogger(filepath, 1024, std::chrono::milliseconds(0), {TestChannel});
+		fileLogger.logFrom(Uuid(3, 4), "buffered\n");
+		EXPECT_EQ(readFile(filepath), "");
+
+		// A message from an immediate channel flushes the whole buffer
+		fileLogger.logFrom(TestChannel, "durable\n");
+		EXPECT_EQ(readFile(filepath), "buffered\ndurable\n");
+
+		fileLogger.log("pending\n");
+		fileLogger.flush();
+		EXPECT_EQ(readFile(filepath), "buffered\ndurable\npending\n");
+		fileLogger.log("closed\n");
+	}
+	EXPECT_EQ(readFile(filepath), "buffered\ndurable\npending\nclosed\n");
+	std::remove(filepath);
+}
+
+TEST(Logger, ChannelGating) {
+	std::shared_ptr<MemoryLogger> memory = std::make_shared<MemoryLogger>();
+	Logger logger = LoggerBuilder()
+		.registerChannelAt(TestChannel, memory, [](const String& msg){ return msg; })
+		.create();
+
+	cint evaluations = 0;
+	auto argument = [&evaluations]() { ++evaluations; return (cint) 1; };
+
+	EXPECT_TRUE(logger.isEnabled(TestChannel));
+	EXPECT_FALSE(logger.isEnabled(Uuid(3, 4)));
+	CASIMIR_LOG(logger, LoggerLevel::Info, TestChannel) << argument();
+	CASIMIR_LOG(logger, LoggerLevel::Info, Uuid(3, 4)) << argument();
+	EXPECT_EQ(evaluations, 1);
+
+	logger.setEnabled(TestChannel, false);
+	EXPECT_FALSE(logger.isEnabled(TestChannel));
+	EXPECT_FALSE(logger(TestChannel).isEnabled());
+	CASIMIR_LOG(logger, LoggerLevel::Error, TestChannel) << argument();
+	logger(TestChannel) << "discarded";
+	EXPECT_EQ(evaluations, 1);
+
+	logger.setEnabled(TestChannel, true);
+	logger(TestChannel) << "kept";
+	ASSERT_EQ(memory->messages.size(), 2);
+	EXPECT_TRUE(memory->messages[1] == "kept");
+}
+
+TEST(Logger, MacroInsideIfElse) {
+	std::shared_ptr<MemoryLogger> memory = std::make_shared<MemoryLogger>();
+	Logger logger = LoggerBuilder()
+		.registerChannelAt(TestChannel, memory, [](const String& msg){ return msg; })
+		.create();
+
+	// The else must belong to the caller's if, whether the channel is enabled or not
+	cint elseCount = 0;
+	for (const bool condition : {true, false}) {
+		if (condition) CASIMIR_LOG(logger, LoggerLevel::Info, TestChannel) << "enabled";
+		else ++elseCount;
+		if (condition) CASIMIR_LOG(logger, LoggerLevel::Info, Uuid(3, 4)) << "unknown";
+		else ++elseCount;
+	}
+	EXPECT_EQ(elseCount, 2);
+	ASSERT_EQ(memory->messages.size(), 1);
+	EXPECT_TRUE(memory->messages[0] == "enabled");
+}
+
+TEST(Logger, ChannelHandle) {
+	std::shared_ptr<MemoryLogger> memory = std::make_shared<MemoryLogger>();
+	Logger logger = LoggerBuilder()
+		.registerChannelAt(TestChannel, memory, [](const String& msg){ return msg; })
+		.create();
+
+	const LoggerChannelHandle handle = logger.resolve(TestChannel);
+	const LoggerChannelHandle unknown = logger.resolve(Uuid(3, 4));
+	EXPECT_TRUE(handle.isEnabled());
+	EXPECT_FALSE(unknown.isEnabled());
+	EXPECT_FALSE(LoggerChannelHandle().isEnabled());
+
+	handle() << "first";
+	unknown() << "lost";
+	LoggerChannelHandle()() << "lost";
+	logger.setEnabled(TestChannel, false);
+	CASIMIR_LOG_HANDLE(handle, LoggerLevel::Info) << "disabled";
+	logger.setEnabled(TestChannel, true);
+	CASIMIR_LOG_HANDLE(handle, LoggerLevel::Info) << "second";
+
+	ASSERT_EQ(memory->messages.size(), 2);
+	EXPECT_TRUE(memory->messages[0] == "first");
+	EXPECT_TRUE(memory->messages[1] == "second");
+}
+
+TEST(Logger, DeferredArguments) {
+	LoggerArguments arguments;
+	const void* ptr = &arguments;
+	arguments.appendInteger(-42);
+	arguments.appendUnsigned(7);
+	arguments.appendDouble(0.5);
+	arguments.appendFloat(1.5f);
+	arguments.appendPointer(ptr);
+	arguments.appendText("abc", 3);
+	EXPECT_LE(arguments.size(), LoggerArguments::InlineCapacity);
+	const String expected = String::toString((cint) -42) + String::toString((cint) 7) + String::toString(0.5)
+		+ String::toString(1.5f) + String((char*) &ptr, sizeof(void*)).encodeToHex() + "abc";
+	EXPECT_TRUE(arguments.render() == expected);
+
+	// Spill to the heap and move
+	const String longText = String('x', 4 * LoggerArguments::InlineCapacity);
+	arguments.appendText(longText.c_str(), longText.length());
+	LoggerArguments moved = std::move(arguments);
+	EXPECT_EQ(arguments.size(), 0);
+	EXPECT_TRUE(moved.render() == expected + longText);
+}
+
+TEST(Logger, DeferredArgumentsAsynchronous) {
+	std::shared_ptr<MemoryLogger> memory = std::make_shared<MemoryLogger>();
+	Logger logger = LoggerBuilder()
+		.registerChannelAt(TestChannel, memory, [](const String& msg){ return "> " + msg; })
+		.setAsynchronous(16)
+		.create();
+
+	{
+		// The text must be captured by the adapter and not referenced
+		std::string text = "value ";
+		logger(TestChannel) << text.c_str() << (cint) 3 << " " << 2.5;
+		text = "changed";
+	}
+	logger.flush();
+
+	ASSERT_EQ(memory->messages.size(), 1);
+	EXPECT_TRUE(memory->messages[0] == "> value 3 " + String::toString(2.5));
+}
+
+TEST(Logger, AsynchronousCallSiteTime) {
+	using Clock = std::chrono::system_clock;
+	std::shared_ptr<MemoryLogger> memory = std::make_shared<MemoryLogger>();
+	std::vector<Clock::time_point> times;
+	Logger logger = LoggerBuilder()
+		.registerChannelAt(TestChannel, memory, [&times](const String& msg, Clock::time_point time) {
+			// The background thread is late on the producer
+			times.push_back(time);
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			return msg;
+		})
+		.setAsynchronous(16)
+		.create();
+
+	const Clock::time_point before = Clock::now();
+	for (cint i = 0; i < 3; ++i) logger(TestChannel) << i;
+	const Clock::time_point after = Clock::now();
+	logger.flush();
+
+	ASSERT_EQ(times.size(), 3);
+	for (const Clock::time_point& time : times) {
+		EXPECT_TRUE(time >= before && time <= after);
+	}
+}
+
+TEST(Logger, RepeatCoalescing) {
+	std::shared_ptr<MemoryLogger> memory = std::make_shared<MemoryLogger>();
+	Logger logger = LoggerBuilder()
+		.registerChannelAt(TestChannel, memory, [](const String& msg){ return msg; })
+		.setRepeatCoalescing(TestChannel)
+		.create();
+
+	for (cint i = 0; i < 5; ++i) logger(TestChannel) << "failure " << (cint) 1;
+	logger(TestChannel) << "failure " << (cint) 2;
+	logger(TestChannel) << "failure " << (cint) 2;
+	logger.flush();
+
+	// The last message is still remembered after the summary has been logged
+	logger(TestChannel) << "failure " << (cint) 2;
+	logger.flush();
+
+	ASSERT_EQ(memory->messages.size(), 5);
+	EXPECT_TRUE(memory->messages[0] == "failure 1");
+	EXPECT_TRUE(memory->messages[1] == "Last message repeated 4 times");
+	EXPECT_TRUE(memory->messages[2] == "failure 2");
+	EXPECT_TRUE(memory->messages[3] == "Last message repeated 1 time");
+	EXPECT_TRUE(memory->messages[4] == "Last message repeated 1 time");
+}
+
+TEST(Logger, RateLimit) {
+	std::shared_ptr<MemoryLogger> memory = std::make_shared<MemoryLogger>();
+	{
+		Logger logger = LoggerBuilder()
+			.registerChannelAt(TestChannel, memory, [](const String& msg){ return msg; })
+			.setRateLimit(TestChannel, 1, 3)
+			.create();
+		for (cint i = 0; i < 10; ++i) logger(TestChannel) << i;
+	}
+
+	// The summary is logged when the Logger is destroyed
+	ASSERT_EQ(memory->messages.size(), 4);
+	EXPECT_TRUE(memory->messages[0] == "0");
+	EXPECT_TRUE(memory->messages[2] == "2");
+	EXPECT_TRUE(memory->messages[3] == "7 messages suppressed by the rate limit");
+
+	EXPECT_THROW(LoggerBuilder().setRateLimit(TestChannel, 1, 1), Exception);
+}
+
+#ifndef _WIN32
+TEST(Logger, DirectShellLogger) {
+	const char* filepath = "casimir_direct_shell_logger_test.log";
+	std::remove(filepath);
+
+	// Redirect stdout to a regular file for the duration of the test
+	std::fflush(stdout);
+	const int savedStdout = dup(STDOUT_FILENO);
+	const int fd = open(filepath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	ASSERT_GE(fd, 0);
+	dup2(fd, STDOUT_FILENO);
+	close(fd);
+	{
+		ShellLogger blockLogger(ShellLoggerStream::Stdout, ShellLoggerBuffering::Auto, 1024, std::chrono::milliseconds(0));
+		EXPECT_FALSE(blockLogger.isLineBuffered());
+		blockLogger.log("first\n");
+		blockLogger.log("second\n");
+		EXPECT_EQ(readFile(filepath), "");
+		blockLogger.flush();
+		EXPECT_EQ(readFile(filepath), "first\nsecond\n");
+
+		ShellLogger lineLogger(ShellLoggerStream::Stdout, ShellLoggerBuffering::Line, 1024);
+		EXPECT_TRUE(lineLogger.isLineBuffered());
+		lineLogger.log("partial ");
+		EXPECT_EQ(readFile(filepath), "first\nsecond\n");
+		lineLogger.log("line\n");
+		EXPECT_EQ(readFile(filepath), "first\nsecond\npartial line\n");
+		blockLogger.log("closed\n");
+	}
+	dup2(savedStdout, STDOUT_FILENO);
+	close(savedStdout);
+
+	EXPECT_EQ(readFile(filepath), "first\nsecond\npartial line\nclosed\n");
+	std::remove(filepath);
+}
+#endif
+
+#ifdef __linux__
+TEST(Logger, WriteErrorsAreReported) {
+	// Every write to /dev/full fails with ENOSPC
+	FileLogger direct("/dev/full");
+	EXPECT_THROW(direct.log("lost\n"), Exception);
+	EXPECT_THROW(direct.log("lost again\n"), Exception);
+
+	FileLogger buffered("/dev/full", 1024, std::chrono::milliseconds(0));
+	buffered.log("buffered\n");
+	EXPECT_THROW(buffered.flush(), Exception);
+	EXPECT_NO_THROW(buffered.flush()); // The failed buffer has been discarded
+
+	// A synchronous Logger cannot hand the error to the caller, it must not stop it either
+	Logger logger = LoggerBuilder()
+		.registerChannelAt(TestChannel, std::make_shared<FileLogger>("/dev/full"), [](const String& msg){ return msg; })
+		.create();
+	logger(TestChannel) << "lost";
+}
+#endif
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/segment_logger.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+static String segmentPath(const String& basePath, cint index) {
+	const String value = String::toString(index);
+	return basePath + "." + String('0', toUnsigned(6 - (cint) value.length())) + value;
+}
+
+static std::vector<String> readSegments(const String& basePath, cint count) {
+	std::vector<String> contents;
+	for (cint i = 0; i < count; ++i) {
+		std::ifstream stream(segmentPath(basePath, i).c_str(), std::ios_base::in | std::ios_base::binary);
+		if (!stream.is_open()) continue;
+		contents.push_back(std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()));
+	}
+	return contents;
+}
+
+static void removeSegments(const String& basePath, cint count) {
+	for (cint i = 0; i < count; ++i) std::remove(segmentPath(basePath, i).c_str());
+}
+
+TEST(SegmentLogger, Rotation) {
+	const String basePath = "casimir_segment_logger_test.log";
+	removeSegments(basePath, 1000);
+
+	const cint threadCount = 4;
+	const cint messageCount = 500;
+	cuint dropped;
+	{
+		SegmentLogger logger(basePath, 4096);
+		std::vector<std::thread> threads;
+		for (cint t = 0; t < threadCount; ++t) {
+			threads.emplace_back([&logger, t]() {
+				for (cint i = 0; i < messageCount; ++i) {
+					logger.log("[" + String::toString(t) + ":" + String('x', 20) + "]\n");
+				}
+			});
+		}
+		for (auto& thread : threads) thread.join();
+		dropped = logger.droppedCount();
+	}
+
+	// Every message is stored entirely within a single segment and the unused part of a segment is truncated
+	cint found = 0;
+	for (const String& content : readSegments(basePath, 1000)) {
+		EXPECT_TRUE(content.endsWith("]\n"));
+		for (const String& line : content.split("\n", true)) {
+			EXPECT_TRUE(line.startsWith("[") && line.endsWith(String('x', 20) + "]"));
+			++found;
+		}
+	}
+	EXPECT_EQ(found + (cint) dropped, threadCount * messageCount);
+	removeSegments(basePath, 1000);
+}
+
+TEST(SegmentLogger, BoundedSegments) {
+	const String basePath = "casimir_segment_logger_bounded_test.log";
+	removeSegments(basePath, 1000);
+	{
+		SegmentLogger logger(basePath, 64, 3);
+		for (cint i = 0; i < 200; ++i) {
+			logger.log(String('a', 32));
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		}
+		EXPECT_THROW(SegmentLogger(basePath, 64, 2), Exception);
+	}
+	EXPECT_LE(readSegments(basePath, 1000).size(), 3);
+	removeSegments(basePath, 1000);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/string_builder.hpp>
+#include <casimir/utilities/exception.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+TEST(StringBuilder, Append) {
+	StringBuilder builder(16);
+	builder.append("Hello").append(' ').append(String("world")).append(3, '!');
+	EXPECT_EQ(builder.length(), 14);
+	builder.appendAll(" ", std::string("and"), StringView(" welcome!!", 8), String());
+	EXPECT_TRUE(builder.build() == "Hello world!!! and welcome");
+
+	// The builder is left empty and can be reused
+	EXPECT_EQ(builder.length(), 0);
+	EXPECT_TRUE(builder.append(String("a\0b", 3)).build() == String("a\0b", 3));
+}
+
+TEST(StringBuilder, Concat) {
+	const String file("file.cpp");
+	EXPECT_TRUE(StringBuilder::concat("[", file, " @ ", String::toString((cint) 42), "]") == "[file.cpp @ 42]");
+	EXPECT_TRUE(StringBuilder::concat("") == "");
+
+	// The Exception message is built in one pass
+	const Exception exception("IndexOutOfRange", "Out of range", file, 42);
+	EXPECT_TRUE(exception.toString() == "[file.cpp @ 42]:\n\t Error {IndexOutOfRange} : Out of range");
+}
+
+TEST(StringBuilder, Concatenation) {
+	const String a("Hello");
+	EXPECT_TRUE(a + " " + String("world") + "!" == "Hello world!");
+	EXPECT_TRUE(String(a) + a == "HelloHello");
+	EXPECT_TRUE(a == "Hello");
+}
+
+TEST(StringBuilder, Join) {
+	EXPECT_TRUE(String(", ").join({"a", "b", "c"}) == "a, b, c");
+	EXPECT_TRUE(String(", ").join({"a", "", "c"}) == "a, c");
+	EXPECT_TRUE(String(", ").join({"a", "", "c"}, false) == "a, , c");
+	EXPECT_TRUE(String(", ").join({"", "b"}, false) == ", b");
+	EXPECT_TRUE(String(", ").join(std::vector<String>()) == "");
+	EXPECT_TRUE(String("-").join((cint) 1, (cint) 2, (cint) 3) == "1-2-3");
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/string_interner.hpp>
+
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+TEST(StringInterner, Deduplication) {
+	StringInterner interner;
+	const InternedString error = interner.intern("ERROR");
+	const InternedString info = interner.intern(String("INFO"));
+	EXPECT_EQ(interner.size(), 2);
+	EXPECT_EQ(error.id(), 1);
+	EXPECT_EQ(info.id(), 2);
+
+	// The same String always gives the same handle (and a single copy of it)
+	const String name("ERROR-channel");
+	const InternedString again = interner.intern(StringView(name).substr(0, 5));
+	EXPECT_TRUE(again == error);
+	EXPECT_TRUE(again != info);
+	EXPECT_EQ(&again.str(), &error.str());
+	EXPECT_EQ(again.hash(), error.hash());
+	EXPECT_TRUE(error.str() == "ERROR");
+	EXPECT_TRUE(info.view() == "INFO");
+	EXPECT_EQ(interner.size(), 2);
+
+	// The empty string is never stored
+	EXPECT_TRUE(interner.intern("") == InternedString());
+	EXPECT_TRUE(InternedString().isEmpty());
+	EXPECT_TRUE(InternedString().str() == "");
+	EXPECT_EQ(InternedString().id(), 0);
+	EXPECT_EQ(interner.size(), 2);
+}
+
+TEST(StringInterner, Find) {
+	StringInterner interner;
+	InternedString result;
+	EXPECT_FALSE(interner.find("WARN", result));
+	EXPECT_EQ(interner.size(), 0);
+	const InternedString warn = interner.intern("WARN");
+	ASSERT_TRUE(interner.find("WARN", result));
+	EXPECT_TRUE(result == warn);
+
+	// The handles can be used as keys of a hash map
+	std::unordered_map<InternedString, cuint> counts;
+	counts[warn] += 1;
+	counts[interner.intern("WARN")] += 1;
+	counts[interner.intern("NOTE")] += 1;
+	EXPECT_EQ(counts.size(), 2);
+	EXPECT_EQ(counts[warn], 2);
+}
+
+TEST(StringInterner, Concurrent) {
+	StringInterner interner;
+	const cuint threadCount = 4;
+	const cuint nameCount = 500;
+	std::vector<std::vector<InternedString>> handles(threadCount);
+	std::vector<std::thread> threads;
+	for (cuint t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&interner, &handles, t]() {
+			for (cuint i = 0; i < nameCount; ++i) {
+				// Each thread interns the names in a different order
+				handles[t].push_back(interner.intern("name-" + String::toString((cint) ((i * (t + 1)) % nameCount))));
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	// Every thread got the same handle for the same name
+	EXPECT_EQ(interner.size(), nameCount);
+	for (cuint t = 0; t < threadCount; ++t) {
+		for (cuint i = 0; i < nameCount; ++i) {
+			const cuint name = (i * (t + 1)) % nameCount;
+			EXPECT_TRUE(handles[t][i] == interner.intern("name-" + String::toString((cint) name)));
+			EXPECT_TRUE(handles[t][i].str() == "name-" + String::toString((cint) name));
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/string_replacer.hpp>
+
+#include <random>
+#include <string>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+TEST(StringReplacer, SingleBytes) {
+	const StringReplacer separators({{"{", ""}, {"}", ""}, {"-", ""}});
+	EXPECT_TRUE(separators.apply("{b4ae1b1e-141f-4f3b-b730-e7b4f86fb1e9}") == "b4ae1b1e141f4f3bb730e7b4f86fb1e9");
+	EXPECT_EQ(separators.count("{b4ae1b1e-141f-4f3b-b730-e7b4f86fb1e9}"), 6);
+	EXPECT_TRUE(separators.apply("") == "");
+	EXPECT_TRUE(separators.apply("---") == "");
+
+	// The replacements may be longer than the patterns
+	const StringReplacer escape({{"\n", "\\n"}, {"\t", "\\t"}, {String("\0", 1), "\\0"}});
+	EXPECT_TRUE(escape.apply(String("a\nb\tc\0", 6)) == "a\\nb\\tc\\0");
+}
+
+TEST(StringReplacer, MultiplePatterns) {
+	// The longest pattern wins and the replacements are never rescanned
+	const StringReplacer replacer({{"a", "1"}, {"ab", "2"}, {"abc", "3"}, {"c", "abc"}, {"", "ignored"}});
+	EXPECT_TRUE(replacer.apply("abcabxac") == "32x1abc");
+	EXPECT_TRUE(replacer.apply("ab") == "2");
+	EXPECT_TRUE(replacer.apply("zzz") == "zzz");
+
+	// The first replacement of a pattern listed twice is used
+	EXPECT_TRUE(StringReplacer({{"x", "1"}, {"x", "2"}, {"xy", "3"}, {"xy", "4"}}).apply("xxy") == "13");
+
+	// Overlapping occurrences are replaced from left to right
+	EXPECT_TRUE(String("aaaa").replaceAll({{"aa", "b"}}) == "bb");
+	EXPECT_TRUE(String("I don't like this because thisthis").replaceAll({{"this", "@"}, {"like", "love"}})
+		== "I don't love @ because @@");
+}
+
+TEST(StringReplacer, MatchesSequentialReplaceAll) {
+	// Patterns that cannot overlap give the same result as a chain of String::replaceAll
+	std::mt19937 generator(7);
+	const char alphabet[] = "ab{}-";
+	for (cuint round = 0; round < 100; ++round) {
+		std::string text(generator() % 200, ' ');
+		for (char& c : text) c = alphabet[generator() % 5];
+		const String expected = String(text).replaceAll("{", "").replaceAll("}", "<>").replaceAll("-", "");
+		EXPECT_TRUE(String(text).replaceAll({{"{", ""}, {"}", "<>"}, {"-", ""}}) == expected);
+	}
+}
+
+TEST(StringReplacer, LongTexts) {
+	// Texts spanning several blocks of the scan, with occurrences across their boundaries
+	std::mt19937 generator(11);
+	const char alphabet[] = "xyz{}-\x80\xff";
+	for (cuint round = 0; round < 20; ++round) {
+		std::string text(generator() % 10000, ' ');
+		for (char& c : text) c = alphabet[generator() % 8];
+		const String expected = String(text).replaceAll("{x}", "1").replaceAll("--", "=").replaceAll("\xff", "2")
+			.replaceAll("\x80y", "333");
+		EXPECT_TRUE(String(text).replaceAll({{"{x}", "1"}, {"--", "="}, {"\xff", "2"}, {"\x80y", "333"}}) == expected);
+	}
+}
@@ -2,6 +2,9 @@
 #include <casimir/utilities/string.hpp>
 #include <casimir/utilities/exception.hpp>
 
+#include <cstdio>
+#include <random>
+
 using namespace Casimir;
 using namespace utilities;
 using namespace literals;
@@ -76,14 +79,96 @@ TEST(String, Find) {
 	EXPECT_EQ(String("").findFirstOf(""), 0);
 }
 
+TEST(String, FindLongInputs) {
+	// Small alphabet so that the first and last bytes of the needle often match without an occurrence
+	std::mt19937 generator(42);
+	std::string text(3000, 'a');
+	for (char& c : text) c = (char) ('a' + generator() % 3);
+	const String haystack(text);
+	for (cuint needleLength : {1, 2, 3, 7, 33, 70}) {
+		for (cuint start = 0; start < 200; start += 13) {
+			const std::string needle = text.substr(start * 11 % (text.size() - needleLength), needleLength);
+			for (cuint from : {(cuint) 0, start, (cuint) 2990}) {
+				const size_t expected = text.find(needle, from);
+				EXPECT_EQ(haystack.findFirstOf(needle, from), expected == std::string::npos ? String::notFound() : expected);
+			}
+			for (cuint before : {(cuint) text.size() - 1, start * 7, (cuint) 5}) {
+				const size_t expected = before + 1 < needleLength ? std::string::npos :
+					text.rfind(needle, before + 1 - needleLength);
+				EXPECT_EQ(haystack.findLastOf(needle, before), expected == std::string::npos ? String::notFound() : expected);
+			}
+		}
+	}
+	EXPECT_EQ(haystack.findFirstOf("d"), String::notFound());
+	EXPECT_EQ(haystack.findLastOf(String('b', 100)), String::notFound());
+	EXPECT_EQ(String(text + "needle" + text).findFirstOf("needle"), text.size());
+	EXPECT_EQ(String(text + "needle" + text).findLastOf("needle"), text.size());
+}
+
 TEST(String, Replacement) {
 	EXPECT_TRUE(String("I don't like this because thisthis th is is this this is not").replaceAll("this", "@")
 		== String("I don't like @ because @@ th is is @ @ is not"));
+	EXPECT_TRUE(String("this is this").replaceAll("this", "that") == String("that is that"));
+	EXPECT_TRUE(String("aaa").replaceAll("a", "") == String(""));
+	EXPECT_TRUE(String("abc").replaceAll("", "x") == String("abc"));
 }
 
 TEST(String, LowerUpperCase) {
 	EXPECT_TRUE(String("Hello world and welcome 654").toUpperCase() == String("HELLO WORLD AND WELCOME 654"));
 	EXPECT_TRUE(String("THIS is NOT very 5456").toLowerCase() == String("this is not very 5456"));
+
+	String a = "Hello World";
+	a.makeUpperCase();
+	EXPECT_TRUE(a == "HELLO WORLD");
+	a.makeLowerCase();
+	EXPECT_TRUE(a == "hello world");
+}
+
+TEST(String, LowerUpperCaseLongInputs) {
+	// Every byte value at every position of the vector blocks, only the ASCII letters are converted
+	for (cuint length : {1, 15, 16, 17, 31, 32, 33, 64, 100, 300}) {
+		std::string data(length, '\0');
+		for (cuint start = 0; start < 256; start += 7) {
+			for (cuint i = 0; i < length; ++i) data[i] = (char) ((start + i) % 256);
+			std::string upper = data;
+			std::string lower = data;
+			for (char& c : upper) if (c >= 'a' && c <= 'z') c -= 0x20;
+			for (char& c : lower) if (c >= 'A' && c <= 'Z') c += 0x20;
+			EXPECT_TRUE(String(data).toUpperCase() == upper);
+			EXPECT_TRUE(String(data).toLowerCase() == lower);
+
+			String inPlace(data);
+			inPlace.makeUpperCase();
+			EXPECT_TRUE(inPlace == upper);
+			inPlace.makeLowerCase();
+			EXPECT_TRUE(inPlace == String(upper).toLowerCase());
+		}
+	}
+}
+
+TEST(String, CharacterClasses) {
+	EXPECT_EQ(String("0123456789abcdefABCDEF").findFirstNotHex(), String::notFound());
+	EXPECT_EQ(String("").findFirstNotHex(), String::notFound());
+	EXPECT_TRUE(String("Hello world").isAscii());
+	EXPECT_FALSE(String("H\xc3\xa9llo").isAscii());
+	EXPECT_TRUE(String("").isAscii());
+	EXPECT_EQ(String("Hello world").count('o'), 2);
+	EXPECT_EQ(String("Hello world").count('z'), 0);
+	EXPECT_EQ(StringView("a\nb\nc").count('\n'), 2);
+
+	for (cuint length : {1, 15, 16, 17, 31, 32, 33, 64, 100, 9000}) {
+		const std::string hex(length, 'f');
+		for (cuint position : {(cuint) 0, length / 2, length - 1}) {
+			for (char invalid : {'g', 'G', '/', ':', '@', '`', ' ', '\xff'}) {
+				std::string corrupted = hex;
+				corrupted[position] = invalid;
+				EXPECT_EQ(String(corrupted).findFirstNotHex(), position);
+				EXPECT_EQ(String(corrupted).isAscii(), invalid != '\xff');
+				EXPECT_EQ(String(corrupted).count(invalid), 1);
+				EXPECT_EQ(String(corrupted).count('f'), length - 1);
+			}
+		}
+	}
 }
 
 TEST(String, HexConvertion) {
@@ -94,6 +179,44 @@ TEST(String, HexConvertion) {
 	EXPECT_TRUE(String("e454fc12AL").decodeFromHex().isEmpty());
 }
 
+TEST(String, HexLongInputs) {
+	std::mt19937 generator(7);
+	for (cuint length : {1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 200, 1000}) {
+		std::string data(length, '\0');
+		for (char& c : data) c = (char) generator();
+		std::string expected;
+		for (char c : data) {
+			char digits[3];
+			std::snprintf(digits, sizeof(digits), "%02x", (unsigned char) c);
+			expected += digits;
+		}
+		const String encoded = String(data).encodeToHex();
+		EXPECT_TRUE(encoded == expected);
+		EXPECT_TRUE(encoded.decodeFromHex() == data);
+		EXPECT_TRUE(encoded.toUpperCase().decodeFromHex() == data);
+
+		// The first invalid character is reported whatever its position in the vector blocks
+		for (cuint position : {(cuint) 0, length / 2, 2 * length - 1}) {
+			for (char invalid : {'g', 'G', '/', ':', '@', '`', ' ', '\xff'}) {
+				std::string corrupted = expected;
+				corrupted[position] = invalid;
+				if (position + 3 < corrupted.length()) corrupted[position + 3] = 'z';
+				cuint invalidPosition;
+				EXPECT_TRUE(String(corrupted).decodeFromHex(invalidPosition).isEmpty());
+				EXPECT_EQ(invalidPosition, position);
+			}
+		}
+	}
+
+	cuint invalidPosition;
+	EXPECT_TRUE(String("abc").decodeFromHex(invalidPosition).isEmpty());
+	EXPECT_EQ(invalidPosition, 2);
+	EXPECT_TRUE(String("a-c").decodeFromHex(invalidPosition).isEmpty());
+	EXPECT_EQ(invalidPosition, 1);
+	EXPECT_TRUE(String("").decodeFromHex(invalidPosition).isEmpty());
+	EXPECT_EQ(invalidPosition, String::notFound());
+}
+
 TEST(String, Insertion) {
 	EXPECT_THROW(String("A").insert(2, ""), Exception);
 	String a = "Test";
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/string.hpp>
+#include <casimir/utilities/string_view.hpp>
+#include <casimir/utilities/exception.hpp>
+
+#include <vector>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+static std::vector<String> tokens(StringSplitter splitter) {
+	std::vector<String> result;
+	for (const StringView& token : splitter) result.push_back(token.toString());
+	return result;
+}
+
+TEST(StringView, ViewsWithoutCopy) {
+	const String text("Hello world");
+	const StringView view(text);
+	EXPECT_EQ(view.data(), text.c_str());
+	EXPECT_EQ(view.length(), 11);
+	EXPECT_EQ(view[4], 'o');
+	EXPECT_THROW(view.at(11), Exception);
+
+	const StringView world = view.substr(6, 5);
+	EXPECT_EQ(world.data(), text.c_str() + 6);
+	EXPECT_TRUE(world == "world");
+	EXPECT_TRUE(world != "World");
+	EXPECT_TRUE(String(world) == "world");
+	EXPECT_TRUE(view.substr(11, 0).isEmpty());
+	EXPECT_THROW(view.substr(6, 6), Exception);
+
+	// Null bytes are part of the view
+	EXPECT_TRUE(StringView("a\0b", 3) != StringView("a"));
+	EXPECT_EQ(StringView("a\0b", 3).findFirstOf("b"), 2);
+}
+
+TEST(StringView, SearchAndCompare) {
+	const StringView view("I AI IA IA");
+	EXPECT_EQ(view.findFirstOf("IA"), 5);
+	EXPECT_EQ(view.findFirstOf("IA", 6), 8);
+	EXPECT_EQ(view.findLastOf("IA"), 8);
+	EXPECT_EQ(view.findLastOf("IA", 8), 5);
+	EXPECT_EQ(view.findFirstOf("B"), StringView::notFound());
+	EXPECT_THROW(view.findLastOf("I", 10), Exception);
+	EXPECT_EQ(StringView().findLastOf(""), 0);
+
+	EXPECT_TRUE(view.startsWith("I AI"));
+	EXPECT_TRUE(view.endsWith(" IA"));
+	EXPECT_FALSE(view.startsWith("I AI IA IA "));
+	EXPECT_FALSE(view.endsWith("AI"));
+
+	// String accepts views (and Strings) for its own search and compare methods
+	const String text("Hello world");
+	EXPECT_EQ(text.findFirstOf(view.substr(4, 1)), 5);
+	EXPECT_TRUE(text.startsWith(StringView("Hello world", 5)));
+	EXPECT_TRUE(text.endsWith(String("world")));
+}
+
+TEST(StringView, LazySplit) {
+	EXPECT_EQ(tokens(StringView("a,b,,c").split(",")), std::vector<String>({"a", "b", "", "c"}));
+	EXPECT_EQ(tokens(StringView("a,b,,c").split(",", true)), std::vector<String>({"a", "b", "c"}));
+	EXPECT_EQ(tokens(StringView(",a,").split(",")), std::vector<String>({"", "a"}));
+	EXPECT_EQ(tokens(StringView("a--b-").split("--")), std::vector<String>({"a", "b-"}));
+	EXPECT_EQ(tokens(StringView("abc").split("")), std::vector<String>({"abc"}));
+	EXPECT_EQ(tokens(StringView().split(",")), std::vector<String>({""}));
+	EXPECT_TRUE(tokens(StringView().split(",", true)).empty());
+
+	// The tokens are views of the split text
+	const String text("key=value");
+	StringSplitter splitter = StringView(text).split("=");
+	StringView token;
+	ASSERT_TRUE(splitter.next(token));
+	EXPECT_EQ(token.data(), text.c_str());
+	ASSERT_TRUE(splitter.next(token));
+	EXPECT_EQ(token.data(), text.c_str() + 4);
+	EXPECT_FALSE(splitter.next(token));
+
+	// String::split yields the same tokens
+	for (const char* input : {"a,b,,c", ",a,", ",,", "abc"}) {
+		EXPECT_EQ(String(input).split(","), tokens(StringView(input).split(",")));
+		EXPECT_EQ(String(input).split(",", true), tokens(StringView(input).split(",", true)));
+	}
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <casimir/utilities/timestamp.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+static std::chrono::system_clock::time_point fromMicroseconds(int64 microseconds) {
+	return std::chrono::system_clock::time_point(
+		std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(microseconds)));
+}
+
+TEST(TimestampCache, Format) {
+	TimestampCache cache;
+	const auto timePoint = fromMicroseconds(1700000000123456LL);
+	EXPECT_TRUE(cache.format(timePoint) == "2023-11-14 at 22:13:20 [ UTC+0000 ]");
+	EXPECT_TRUE(cache.format(timePoint) == "2023-11-14 at 22:13:20 [ UTC+0000 ]");
+	EXPECT_TRUE(cache.format(timePoint, TimestampPrecision::Millisecond) == "2023-11-14 at 22:13:20.123 [ UTC+0000 ]");
+	EXPECT_TRUE(cache.format(timePoint, TimestampPrecision::Microsecond) == "2023-11-14 at 22:13:20.123456 [ UTC+0000 ]");
+	EXPECT_TRUE(cache.format(fromMicroseconds(1700000001000000LL)) == "2023-11-14 at 22:13:21 [ UTC+0000 ]");
+}
+
+TEST(TimestampCache, Concurrent) {
+	TimestampCache cache;
+	std::vector<std::thread> threads;
+	// One byte per thread (the bits of a std::vector<bool> would share words between threads)
+	std::vector<char> success(8, 1);
+	for (cuint t = 0; t < success.size(); ++t) {
+		threads.emplace_back([&cache, &success, t]() {
+			for (int64 i = 0; i < 20000; ++i) {
+				const int64 second = 1700000000LL + (i / 100) % 3;
+				const String expected = second == 1700000000LL ? "2023-11-14 at 22:13:20 [ UTC+0000 ]" :
+				                        second == 1700000001LL ? "2023-11-14 at 22:13:21 [ UTC+0000 ]" :
+				                                                 "2023-11-14 at 22:13:22 [ UTC+0000 ]";
+				if (cache.format(fromMicroseconds(second * 1000000LL)) != expected) success[t] = 0;
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+	for (char value : success) EXPECT_TRUE(value);
+}
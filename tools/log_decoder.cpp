@@ -0,0 +1,47 @@
+#include <iostream>
+#include <fstream>
+
+#include <casimir/casimir.hpp>
+#include <casimir/utilities/binary_logger.hpp>
+#include <casimir/utilities/exception.hpp>
+#include <casimir/utilities/timestamp.hpp>
+#include <casimir/core/private-context.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+/**
+ * @brief Expand a binary log file (see utilities::BinaryLogger) into the human-readable layout of the FileLogger
+ * Usage: casimir-log-decoder <binary log> [output file]
+ */
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <binary log> [output file]" << std::endl;
+        return 1;
+    }
+
+    std::ofstream outputFile;
+    if (argc == 3) {
+        outputFile.open(argv[2], std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!outputFile.is_open()) {
+            std::cerr << "Cannot open the output file " << argv[2] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& output = argc == 3 ? (std::ostream&) outputFile : std::cout;
+
+    try {
+        BinaryLogReader reader(argv[1]);
+        TimestampCache timestamps;
+        BinaryLogEntry entry;
+        while (reader.next(entry)) {
+            const String msg = formattedChannelMessage(entry.message, entry.channel, timestamps.format(entry.time()));
+            output.write(msg.c_str(), (std::streamsize) msg.length());
+        }
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <cstring>
+
+#include <casimir/casimir.hpp>
+#include <casimir/utilities/log_index.hpp>
+#include <casimir/utilities/exception.hpp>
+
+using namespace Casimir;
+using namespace utilities;
+using namespace literals;
+
+/**
+ * @brief Parse a timestamp given on the command line
+ * @return false if the argument isn't a timestamp
+ */
+static bool parseArgumentTimestamp(const char* argument, int64& timestamp) {
+    const cuint length = (cuint) strlen(argument);
+    return LogIndex::parseTimestamp(argument, length, timestamp) == length;
+}
+
+/**
+ * @brief Print the records of a text log file (see utilities::FileLogger) that match a channel and a time window.
+ * The sidecar index `<log file>.idx` is created on the first query and only extended by the following ones
+ * Usage: casimir-log-query <log file> [--channel NAME] [--from TIME] [--to TIME] [--count]
+ * where TIME is `YYYY-MM-DD HH:MM:SS` (UTC)
+ */
+int main(int argc, char** argv) {
+    const char* usage = " <log file> [--channel NAME] [--from TIME] [--to TIME] [--count]";
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << usage << std::endl;
+        return 1;
+    }
+
+    String channel;
+    int64 from = std::numeric_limits<int64>::min();
+    int64 to = std::numeric_limits<int64>::max();
+    bool countOnly = false;
+    for (int i = 2; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--channel") == 0 && hasValue) {
+            channel = argv[++i];
+        } else if (strcmp(argv[i], "--from") == 0 && hasValue && parseArgumentTimestamp(argv[i + 1], from)) {
+            ++i;
+        } else if (strcmp(argv[i], "--to") == 0 && hasValue && parseArgumentTimestamp(argv[i + 1], to)) {
+            ++i;
+        } else if (strcmp(argv[i], "--count") == 0) {
+            countOnly = true;
+        } else {
+            std::cerr << "Invalid argument " << argv[i] << std::endl;
+            std::cerr << "Usage: " << argv[0] << usage << std::endl;
+            return 1;
+        }
+    }
+
+    try {
+        LogIndex index(argv[1]);
+        const std::vector<LogIndexEntry> entries = index.query(channel, from, to);
+        if (countOnly) {
+            std::cout << entries.size() << std::endl;
+            return 0;
+        }
+        for (const LogIndexEntry& entry : entries) {
+            const String text = index.text(entry);
+            std::cout.write(text.c_str(), (std::streamsize) text.length());
+        }
+    } catch (const Exception& exception) {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}